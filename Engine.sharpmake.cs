@@ -10,6 +10,7 @@ using Sharpmake;
 [module: Sharpmake.Include("Tools/BaseProject.sharpmake.cs")]
 [module: Sharpmake.Include("Tools/CommonTarget.sharpmake.cs")]
 [module: Sharpmake.Include("Tools/HUB/MitchHub.sharpmake.cs")]
+[module: Sharpmake.Include("Tools/ECSBenchmark/ECSBenchmark.sharpmake.cs")]
 [module: Sharpmake.Include("Tools/SharpmakeProject.sharpmake.cs")]
 
 public abstract class BaseGameProject : BaseProject
@@ -299,6 +300,11 @@ public class BaseGameSolution : Solution
             }
         }
 
+        if(target.SubPlatform != CommonTarget.SubPlatformType.UWP)
+        {
+            conf.AddProject<ECSBenchmarkProject>(target);
+        }
+
         if(target.Platform == Platform.win64)
         {
             conf.AddProject<UserSharpmakeProject>(target);
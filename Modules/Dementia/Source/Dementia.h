@@ -37,6 +37,13 @@ Class& operator=(Class&&) = delete;
 #define ME_PLATFORM_MACOS 0
 #endif
 
+#if defined(ME_PLATFORM_LINUX) || defined(__linux__)
+#undef ME_PLATFORM_LINUX
+#define ME_PLATFORM_LINUX 1
+#else
+#define ME_PLATFORM_LINUX 0
+#endif
+
 #ifdef ME_DIRECTX
 #define ME_DIRECTX 1
 #else
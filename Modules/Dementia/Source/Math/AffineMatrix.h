@@ -0,0 +1,359 @@
+#pragma once
+#include "Matrix4.h"
+
+#include <cmath>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define ME_AFFINE_SSE 1
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#else
+#define ME_AFFINE_SSE 0
+#endif
+
+#if !ME_AFFINE_SSE && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define ME_AFFINE_NEON 1
+#include <arm_neon.h>
+#else
+#define ME_AFFINE_NEON 0
+#endif
+
+// 3x4 affine transform, the bottom row is always (0, 0, 0, 1) and isn't stored.
+// Same convention as glm / Matrix4 (M * point, the first three columns are the basis vectors),
+// but laid out as three rows of (basis x, basis y, basis z, translation) so each row is one SIMD register.
+class alignas(16) AffineMatrix
+{
+public:
+	AffineMatrix()
+		: Rows{ { 1.f, 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f, 0.f }, { 0.f, 0.f, 1.f, 0.f } }
+	{
+	}
+
+	// The bottom row of InMatrix is ignored
+	explicit AffineMatrix(const glm::mat4& InMatrix)
+	{
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			for (int Column = 0; Column < 4; ++Column)
+			{
+				Rows[Row][Column] = InMatrix[Column][Row];
+			}
+		}
+	}
+
+	explicit AffineMatrix(const Matrix4& InMatrix)
+		: AffineMatrix(InMatrix.GetInternalMatrix())
+	{
+	}
+
+	// Same result as translate(T) * toMat4(R) * scale(S)
+	static AffineMatrix FromTRS(const glm::vec3& InPosition, const glm::quat& InRotation, const glm::vec3& InScale)
+	{
+		const glm::mat3 Rotation = glm::mat3_cast(InRotation);
+		AffineMatrix Out;
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			Out.Rows[Row][0] = Rotation[0][Row] * InScale.x;
+			Out.Rows[Row][1] = Rotation[1][Row] * InScale.y;
+			Out.Rows[Row][2] = Rotation[2][Row] * InScale.z;
+			Out.Rows[Row][3] = InPosition[Row];
+		}
+		return Out;
+	}
+
+	glm::mat4 ToGlm() const
+	{
+		return glm::mat4(
+			Rows[0][0], Rows[1][0], Rows[2][0], 0.f,
+			Rows[0][1], Rows[1][1], Rows[2][1], 0.f,
+			Rows[0][2], Rows[1][2], Rows[2][2], 0.f,
+			Rows[0][3], Rows[1][3], Rows[2][3], 1.f);
+	}
+
+	Matrix4 ToMatrix4() const
+	{
+		return Matrix4(ToGlm());
+	}
+
+	// OutMatrix = InA * InB, OutMatrix may alias either input
+	static void Multiply(const AffineMatrix& InA, const AffineMatrix& InB, AffineMatrix& OutMatrix)
+	{
+#if ME_AFFINE_SSE
+		const __m128 B0 = _mm_load_ps(InB.Rows[0]);
+		const __m128 B1 = _mm_load_ps(InB.Rows[1]);
+		const __m128 B2 = _mm_load_ps(InB.Rows[2]);
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			const float* A = InA.Rows[Row];
+			__m128 Result = _mm_mul_ps(_mm_set1_ps(A[0]), B0);
+			Result = _mm_add_ps(Result, _mm_mul_ps(_mm_set1_ps(A[1]), B1));
+			Result = _mm_add_ps(Result, _mm_mul_ps(_mm_set1_ps(A[2]), B2));
+			Result = _mm_add_ps(Result, _mm_set_ps(A[3], 0.f, 0.f, 0.f));
+			_mm_store_ps(OutMatrix.Rows[Row], Result);
+		}
+#elif ME_AFFINE_NEON
+		const float32x4_t B0 = vld1q_f32(InB.Rows[0]);
+		const float32x4_t B1 = vld1q_f32(InB.Rows[1]);
+		const float32x4_t B2 = vld1q_f32(InB.Rows[2]);
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			const float* A = InA.Rows[Row];
+			float32x4_t Result = vsetq_lane_f32(A[3], vdupq_n_f32(0.f), 3);
+			Result = vmlaq_n_f32(Result, B0, A[0]);
+			Result = vmlaq_n_f32(Result, B1, A[1]);
+			Result = vmlaq_n_f32(Result, B2, A[2]);
+			vst1q_f32(OutMatrix.Rows[Row], Result);
+		}
+#else
+		const AffineMatrix B = InB;
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			const float A[4] = { InA.Rows[Row][0], InA.Rows[Row][1], InA.Rows[Row][2], InA.Rows[Row][3] };
+			for (int Column = 0; Column < 4; ++Column)
+			{
+				OutMatrix.Rows[Row][Column] = A[0] * B.Rows[0][Column] + A[1] * B.Rows[1][Column] + A[2] * B.Rows[2][Column];
+			}
+			OutMatrix.Rows[Row][3] += A[3];
+		}
+#endif
+	}
+
+	AffineMatrix operator*(const AffineMatrix& InOther) const
+	{
+		AffineMatrix Out;
+		Multiply(*this, InOther, Out);
+		return Out;
+	}
+
+	glm::vec3 TransformPoint(const glm::vec3& InPoint) const
+	{
+		return TransformRows(InPoint.x, InPoint.y, InPoint.z, 1.f);
+	}
+
+	glm::vec3 TransformVector(const glm::vec3& InVector) const
+	{
+		return TransformRows(InVector.x, InVector.y, InVector.z, 0.f);
+	}
+
+	Vector3 TransformPoint(const Vector3& InPoint) const
+	{
+		return TransformPoint(InPoint.InternalVector);
+	}
+
+	Vector3 TransformVector(const Vector3& InVector) const
+	{
+		return TransformVector(InVector.InternalVector);
+	}
+
+	Vector3 GetPosition() const
+	{
+		return Vector3(Rows[0][3], Rows[1][3], Rows[2][3]);
+	}
+
+	// True when the basis vectors are perpendicular, which holds for any rotation * scale.
+	// InTolerance bounds the cosine of the angle between them, so the scale doesn't matter.
+	bool IsOrthogonal(float InTolerance = 1e-4f) const
+	{
+		const float Len0 = Rows[0][0] * Rows[0][0] + Rows[1][0] * Rows[1][0] + Rows[2][0] * Rows[2][0];
+		const float Len1 = Rows[0][1] * Rows[0][1] + Rows[1][1] * Rows[1][1] + Rows[2][1] * Rows[2][1];
+		const float Len2 = Rows[0][2] * Rows[0][2] + Rows[1][2] * Rows[1][2] + Rows[2][2] * Rows[2][2];
+		const float Dot01 = Rows[0][0] * Rows[0][1] + Rows[1][0] * Rows[1][1] + Rows[2][0] * Rows[2][1];
+		const float Dot02 = Rows[0][0] * Rows[0][2] + Rows[1][0] * Rows[1][2] + Rows[2][0] * Rows[2][2];
+		const float Dot12 = Rows[0][1] * Rows[0][2] + Rows[1][1] * Rows[1][2] + Rows[2][1] * Rows[2][2];
+
+		// dot^2 <= tol^2 * |a|^2 * |b|^2, squared lengths are already at hand and no square root is needed
+		const float Tolerance2 = InTolerance * InTolerance;
+		return Dot01 * Dot01 <= Tolerance2 * Len0 * Len1
+			&& Dot02 * Dot02 <= Tolerance2 * Len0 * Len2
+			&& Dot12 * Dot12 <= Tolerance2 * Len1 * Len2;
+	}
+
+	// Rotation * scale inverts as scale^-1 * rotation^T, so each basis vector divided by its squared length
+	// becomes a row of the inverse. Matrices with shear (non-uniform scale under a rotated parent) take a full 3x3 inverse.
+	AffineMatrix Inverse() const
+	{
+		return IsOrthogonal() ? InverseOrthogonal() : InverseGeneral();
+	}
+
+	// Only valid when IsOrthogonal() holds
+	AffineMatrix InverseOrthogonal() const
+	{
+		AffineMatrix Out;
+#if ME_AFFINE_SSE
+		__m128 R0 = _mm_load_ps(Rows[0]);
+		__m128 R1 = _mm_load_ps(Rows[1]);
+		__m128 R2 = _mm_load_ps(Rows[2]);
+
+		// Lane j holds the squared length of basis vector j
+		__m128 LengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(R0, R0), _mm_mul_ps(R1, R1)), _mm_mul_ps(R2, R2));
+		LengthSq = _mm_max_ps(LengthSq, _mm_set1_ps(1e-20f));
+		const __m128 InvLengthSq = _mm_div_ps(_mm_set1_ps(1.f), LengthSq);
+
+		const __m128 T0 = _mm_set1_ps(Rows[0][3]);
+		const __m128 T1 = _mm_set1_ps(Rows[1][3]);
+		const __m128 T2 = _mm_set1_ps(Rows[2][3]);
+		R0 = _mm_mul_ps(R0, InvLengthSq);
+		R1 = _mm_mul_ps(R1, InvLengthSq);
+		R2 = _mm_mul_ps(R2, InvLengthSq);
+
+		// -inverse(linear) * translation, still column wise so it's three multiply adds
+		__m128 Translation = _mm_add_ps(_mm_add_ps(_mm_mul_ps(R0, T0), _mm_mul_ps(R1, T1)), _mm_mul_ps(R2, T2));
+		Translation = _mm_sub_ps(_mm_setzero_ps(), Translation);
+
+		_MM_TRANSPOSE4_PS(R0, R1, R2, Translation);
+		_mm_store_ps(Out.Rows[0], R0);
+		_mm_store_ps(Out.Rows[1], R1);
+		_mm_store_ps(Out.Rows[2], R2);
+#elif ME_AFFINE_NEON
+		float32x4_t R0 = vld1q_f32(Rows[0]);
+		float32x4_t R1 = vld1q_f32(Rows[1]);
+		float32x4_t R2 = vld1q_f32(Rows[2]);
+
+		float32x4_t LengthSq = vmulq_f32(R0, R0);
+		LengthSq = vmlaq_f32(LengthSq, R1, R1);
+		LengthSq = vmlaq_f32(LengthSq, R2, R2);
+		LengthSq = vmaxq_f32(LengthSq, vdupq_n_f32(1e-20f));
+#if defined(__aarch64__) || defined(_M_ARM64)
+		const float32x4_t InvLengthSq = vdivq_f32(vdupq_n_f32(1.f), LengthSq);
+#else
+		// ARMv7 has no vector divide, two Newton-Raphson steps bring the estimate to full float precision
+		float32x4_t InvLengthSq = vrecpeq_f32(LengthSq);
+		InvLengthSq = vmulq_f32(InvLengthSq, vrecpsq_f32(LengthSq, InvLengthSq));
+		InvLengthSq = vmulq_f32(InvLengthSq, vrecpsq_f32(LengthSq, InvLengthSq));
+#endif
+
+		R0 = vmulq_f32(R0, InvLengthSq);
+		R1 = vmulq_f32(R1, InvLengthSq);
+		R2 = vmulq_f32(R2, InvLengthSq);
+
+		float32x4_t Translation = vmulq_n_f32(R0, Rows[0][3]);
+		Translation = vmlaq_n_f32(Translation, R1, Rows[1][3]);
+		Translation = vmlaq_n_f32(Translation, R2, Rows[2][3]);
+		Translation = vnegq_f32(Translation);
+
+		TransposeNeon(R0, R1, R2, Translation);
+		vst1q_f32(Out.Rows[0], R0);
+		vst1q_f32(Out.Rows[1], R1);
+		vst1q_f32(Out.Rows[2], R2);
+#else
+		for (int Column = 0; Column < 3; ++Column)
+		{
+			float LengthSq = Rows[0][Column] * Rows[0][Column] + Rows[1][Column] * Rows[1][Column] + Rows[2][Column] * Rows[2][Column];
+			LengthSq = LengthSq > 1e-20f ? LengthSq : 1e-20f;
+			const float InvLengthSq = 1.f / LengthSq;
+			for (int Row = 0; Row < 3; ++Row)
+			{
+				Out.Rows[Column][Row] = Rows[Row][Column] * InvLengthSq;
+			}
+		}
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			Out.Rows[Row][3] = -(Out.Rows[Row][0] * Rows[0][3] + Out.Rows[Row][1] * Rows[1][3] + Out.Rows[Row][2] * Rows[2][3]);
+		}
+#endif
+		return Out;
+	}
+
+	AffineMatrix InverseGeneral() const
+	{
+		const float A = Rows[0][0], B = Rows[0][1], C = Rows[0][2];
+		const float D = Rows[1][0], E = Rows[1][1], F = Rows[1][2];
+		const float G = Rows[2][0], H = Rows[2][1], I = Rows[2][2];
+
+		const float CofactorA = E * I - F * H;
+		const float CofactorB = F * G - D * I;
+		const float CofactorC = D * H - E * G;
+		const float Determinant = A * CofactorA + B * CofactorB + C * CofactorC;
+		const float InvDeterminant = (std::fabs(Determinant) > 1e-20f) ? 1.f / Determinant : 0.f;
+
+		AffineMatrix Out;
+		Out.Rows[0][0] = CofactorA * InvDeterminant;
+		Out.Rows[0][1] = (C * H - B * I) * InvDeterminant;
+		Out.Rows[0][2] = (B * F - C * E) * InvDeterminant;
+		Out.Rows[1][0] = CofactorB * InvDeterminant;
+		Out.Rows[1][1] = (A * I - C * G) * InvDeterminant;
+		Out.Rows[1][2] = (C * D - A * F) * InvDeterminant;
+		Out.Rows[2][0] = CofactorC * InvDeterminant;
+		Out.Rows[2][1] = (B * G - A * H) * InvDeterminant;
+		Out.Rows[2][2] = (A * E - B * D) * InvDeterminant;
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			Out.Rows[Row][3] = -(Out.Rows[Row][0] * Rows[0][3] + Out.Rows[Row][1] * Rows[1][3] + Out.Rows[Row][2] * Rows[2][3]);
+		}
+		return Out;
+	}
+
+	bool operator==(const AffineMatrix& InOther) const
+	{
+		for (int Row = 0; Row < 3; ++Row)
+		{
+			for (int Column = 0; Column < 4; ++Column)
+			{
+				if (Rows[Row][Column] != InOther.Rows[Row][Column])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const AffineMatrix& InOther) const
+	{
+		return !(*this == InOther);
+	}
+
+	float Rows[3][4];
+
+private:
+	// Every row dotted with (InX, InY, InZ, InW), InW picks up the translation for points and drops it for vectors
+	glm::vec3 TransformRows(float InX, float InY, float InZ, float InW) const
+	{
+#if ME_AFFINE_SSE
+		const __m128 Vector = _mm_set_ps(InW, InZ, InY, InX);
+		__m128 M0 = _mm_mul_ps(_mm_load_ps(Rows[0]), Vector);
+		__m128 M1 = _mm_mul_ps(_mm_load_ps(Rows[1]), Vector);
+		__m128 M2 = _mm_mul_ps(_mm_load_ps(Rows[2]), Vector);
+		__m128 M3 = _mm_setzero_ps();
+
+		// After the transpose lane i of every register belongs to row i, so summing them finishes all three dot products
+		_MM_TRANSPOSE4_PS(M0, M1, M2, M3);
+		const __m128 Sum = _mm_add_ps(_mm_add_ps(M0, M1), _mm_add_ps(M2, M3));
+
+		alignas(16) float Result[4];
+		_mm_store_ps(Result, Sum);
+		return glm::vec3(Result[0], Result[1], Result[2]);
+#elif ME_AFFINE_NEON
+		const float Components[4] = { InX, InY, InZ, InW };
+		const float32x4_t Vector = vld1q_f32(Components);
+		float32x4_t M0 = vmulq_f32(vld1q_f32(Rows[0]), Vector);
+		float32x4_t M1 = vmulq_f32(vld1q_f32(Rows[1]), Vector);
+		float32x4_t M2 = vmulq_f32(vld1q_f32(Rows[2]), Vector);
+		float32x4_t M3 = vdupq_n_f32(0.f);
+
+		TransposeNeon(M0, M1, M2, M3);
+		const float32x4_t Sum = vaddq_f32(vaddq_f32(M0, M1), vaddq_f32(M2, M3));
+		return glm::vec3(vgetq_lane_f32(Sum, 0), vgetq_lane_f32(Sum, 1), vgetq_lane_f32(Sum, 2));
+#else
+		return glm::vec3(
+			Rows[0][0] * InX + Rows[0][1] * InY + Rows[0][2] * InZ + Rows[0][3] * InW,
+			Rows[1][0] * InX + Rows[1][1] * InY + Rows[1][2] * InZ + Rows[1][3] * InW,
+			Rows[2][0] * InX + Rows[2][1] * InY + Rows[2][2] * InZ + Rows[2][3] * InW);
+#endif
+	}
+
+#if ME_AFFINE_NEON
+	// NEON counterpart of _MM_TRANSPOSE4_PS
+	static void TransposeNeon(float32x4_t& InOutR0, float32x4_t& InOutR1, float32x4_t& InOutR2, float32x4_t& InOutR3)
+	{
+		// (r0x, r1x, r0z, r1z) and (r0y, r1y, r0w, r1w), likewise for rows 2 and 3
+		const float32x4x2_t Low = vtrnq_f32(InOutR0, InOutR1);
+		const float32x4x2_t High = vtrnq_f32(InOutR2, InOutR3);
+		InOutR0 = vcombine_f32(vget_low_f32(Low.val[0]), vget_low_f32(High.val[0]));
+		InOutR1 = vcombine_f32(vget_low_f32(Low.val[1]), vget_low_f32(High.val[1]));
+		InOutR2 = vcombine_f32(vget_high_f32(Low.val[0]), vget_high_f32(High.val[0]));
+		InOutR3 = vcombine_f32(vget_high_f32(Low.val[1]), vget_high_f32(High.val[1]));
+	}
+#endif
+};
@@ -0,0 +1,68 @@
+#include "PoolAllocator.h"
+
+FixedBlockPool::FixedBlockPool(std::size_t InBlockSize, std::size_t InBlockAlignment, std::size_t InBlocksPerSlab)
+	: BlockAlignment(InBlockAlignment < alignof(FreeBlock) ? alignof(FreeBlock) : InBlockAlignment)
+	, BlocksPerSlab(InBlocksPerSlab)
+{
+	// Every block has to fit a free list link and keep the next block aligned
+	const std::size_t size = InBlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : InBlockSize;
+	BlockSize = (size + BlockAlignment - 1) & ~(BlockAlignment - 1);
+}
+
+FixedBlockPool::~FixedBlockPool()
+{
+	for (void* slab : Slabs)
+	{
+		::operator delete(slab, std::align_val_t(BlockAlignment));
+	}
+}
+
+void* FixedBlockPool::Allocate()
+{
+	std::lock_guard<std::mutex> guard(Lock);
+	if (!FreeList)
+	{
+		AllocateSlab();
+	}
+
+	FreeBlock* block = FreeList;
+	FreeList = block->Next;
+	return block;
+}
+
+void FixedBlockPool::Free(void* InBlock)
+{
+	if (!InBlock)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(Lock);
+	FreeBlock* block = static_cast<FreeBlock*>(InBlock);
+	block->Next = FreeList;
+	FreeList = block;
+}
+
+std::size_t FixedBlockPool::GetBlockSize() const
+{
+	return BlockSize;
+}
+
+std::size_t FixedBlockPool::GetSlabCount() const
+{
+	return Slabs.size();
+}
+
+void FixedBlockPool::AllocateSlab()
+{
+	char* slab = static_cast<char*>(::operator new(BlockSize * BlocksPerSlab, std::align_val_t(BlockAlignment)));
+	Slabs.push_back(slab);
+
+	// Link back to front so blocks are handed out in address order
+	for (std::size_t i = BlocksPerSlab; i > 0; --i)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * BlockSize);
+		block->Next = FreeList;
+		FreeList = block;
+	}
+}
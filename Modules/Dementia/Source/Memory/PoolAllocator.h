@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "Dementia.h"
+
+// Hands out fixed size blocks carved from large slabs. Slabs are only released when the pool dies,
+// so a block keeps its address for as long as it is allocated. Freed blocks are kept on an intrusive free list.
+class FixedBlockPool
+{
+public:
+	FixedBlockPool(std::size_t InBlockSize, std::size_t InBlockAlignment, std::size_t InBlocksPerSlab = 256);
+	~FixedBlockPool();
+
+	ME_NONCOPYABLE(FixedBlockPool)
+	ME_NONMOVABLE(FixedBlockPool)
+
+	void* Allocate();
+	void Free(void* InBlock);
+
+	std::size_t GetBlockSize() const;
+	std::size_t GetSlabCount() const;
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* Next;
+	};
+
+	std::size_t BlockSize;
+	std::size_t BlockAlignment;
+	std::size_t BlocksPerSlab;
+
+	FreeBlock* FreeList = nullptr;
+	std::vector<void*> Slabs;
+	std::mutex Lock;
+
+	void AllocateSlab();
+};
+
+// One pool per block size/alignment pair, shared by every type that maps onto it.
+// Pools are never destroyed so objects released during static destruction stay valid.
+template<std::size_t Size, std::size_t Alignment>
+FixedBlockPool& GetFixedBlockPool()
+{
+	static FixedBlockPool* pool = new FixedBlockPool(Size, Alignment);
+	return *pool;
+}
+
+// Standard allocator on top of FixedBlockPool, meant for std::allocate_shared so the object and its control block
+// share one pooled block. InAlignment raises the block alignment (64 gives every object its own cache lines).
+template<typename T, std::size_t InAlignment = 0>
+class PoolAllocator
+{
+public:
+	typedef T value_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef PoolAllocator<U, InAlignment> other;
+	};
+
+	static constexpr std::size_t kAlignment = alignof(T) > InAlignment ? alignof(T) : InAlignment;
+
+	PoolAllocator() = default;
+
+	template<typename U>
+	PoolAllocator(const PoolAllocator<U, InAlignment>&)
+	{
+	}
+
+	T* allocate(std::size_t InCount)
+	{
+		if (InCount == 1)
+		{
+			return static_cast<T*>(GetFixedBlockPool<sizeof(T), kAlignment>().Allocate());
+		}
+		return static_cast<T*>(::operator new(InCount * sizeof(T), std::align_val_t(kAlignment)));
+	}
+
+	void deallocate(T* InPtr, std::size_t InCount)
+	{
+		if (InCount == 1)
+		{
+			GetFixedBlockPool<sizeof(T), kAlignment>().Free(InPtr);
+			return;
+		}
+		::operator delete(InPtr, std::align_val_t(kAlignment));
+	}
+
+	template<typename U>
+	bool operator==(const PoolAllocator<U, InAlignment>&) const
+	{
+		return true;
+	}
+
+	template<typename U>
+	bool operator!=(const PoolAllocator<U, InAlignment>&) const
+	{
+		return false;
+	}
+};
@@ -0,0 +1,56 @@
+#include "StringTable.h"
+#include <assert.h>
+
+StringTable::StringTable()
+{
+	Intern("");
+}
+
+StringTable& StringTable::Get()
+{
+	// Leaked on purpose, names are read during static destruction
+	static StringTable* Table = new StringTable();
+	return *Table;
+}
+
+StringTable::Id StringTable::Intern(std::string_view InString)
+{
+	std::lock_guard<std::mutex> guard(Lock);
+	auto it = Lookup.find(InString);
+	if (it != Lookup.end())
+	{
+		return it->second;
+	}
+
+	const Id NewId = static_cast<Id>(Entries.size());
+	Entries.push_back({ std::string(InString), std::hash<std::string_view>()(InString) });
+	Lookup.emplace(std::string_view(Entries.back().Value), NewId);
+	return NewId;
+}
+
+StringTable::Id StringTable::Find(std::string_view InString) const
+{
+	std::lock_guard<std::mutex> guard(Lock);
+	auto it = Lookup.find(InString);
+	return (it != Lookup.end()) ? it->second : kNotFound;
+}
+
+const std::string& StringTable::GetString(Id InId) const
+{
+	std::lock_guard<std::mutex> guard(Lock);
+	assert(InId < Entries.size());
+	return Entries[InId].Value;
+}
+
+std::size_t StringTable::GetHash(Id InId) const
+{
+	std::lock_guard<std::mutex> guard(Lock);
+	assert(InId < Entries.size());
+	return Entries[InId].Hash;
+}
+
+std::size_t StringTable::GetCount() const
+{
+	std::lock_guard<std::mutex> guard(Lock);
+	return Entries.size();
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Process wide table of interned strings. Equal strings share one id, so comparing or hashing names
+// is an integer operation. Strings are never removed, references from GetString stay valid until exit.
+class StringTable
+{
+public:
+	typedef std::uint32_t Id;
+
+	// The empty string is always interned first
+	static constexpr Id kEmptyId = 0;
+	// Returned by Find for strings that were never interned
+	static constexpr Id kNotFound = static_cast<Id>(-1);
+
+	static StringTable& Get();
+
+	Id Intern(std::string_view InString);
+
+	// Doesn't add anything, a miss means no interned name can match InString
+	Id Find(std::string_view InString) const;
+
+	const std::string& GetString(Id InId) const;
+	std::size_t GetHash(Id InId) const;
+	std::size_t GetCount() const;
+
+private:
+	StringTable();
+
+	struct Entry
+	{
+		std::string Value;
+		std::size_t Hash = 0;
+	};
+
+	// Deque so growing never moves the strings the lookup keys point into
+	std::deque<Entry> Entries;
+	std::unordered_map<std::string_view, Id> Lookup;
+	mutable std::mutex Lock;
+};
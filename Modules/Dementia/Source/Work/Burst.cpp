@@ -7,9 +7,20 @@
 #if ME_PLATFORM_UWP || ME_PLATFORM_WIN64
 #include <synchapi.h>
 #include <assert.h>
-#include <algorithm>
 #include <process.h>
 #endif
+#if ME_PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <thread>
 #include <utility>
 
 namespace Burst
@@ -119,6 +130,136 @@ namespace Burst
 	}
 
 
+#endif
+
+#if ME_PLATFORM_LINUX
+	bool ReadFirstLine(const std::string& InPath, std::string& OutLine)
+	{
+		std::ifstream File(InPath);
+		return File && std::getline(File, OutLine) && !OutLine.empty();
+	}
+
+	int ReadInt(const std::string& InPath, int InDefault)
+	{
+		std::string Line;
+		return ReadFirstLine(InPath, Line) ? std::atoi(Line.c_str()) : InDefault;
+	}
+
+	// Cores worth of CPU time the cgroup grants per period, 0 when there's no limit
+	float ReadCgroupQuota()
+	{
+		// cgroup v2, the unified hierarchy shows up as "0::/path"
+		std::ifstream CgroupFile("/proc/self/cgroup");
+		std::string Line;
+		while (std::getline(CgroupFile, Line))
+		{
+			if (Line.rfind("0::", 0) != 0)
+			{
+				continue;
+			}
+
+			// Inside a container the own cgroup is usually mounted as the root, try that first
+			for (const std::string& Dir : { std::string("/sys/fs/cgroup"), "/sys/fs/cgroup" + Line.substr(3) })
+			{
+				std::string CpuMax;
+				if (!ReadFirstLine(Dir + "/cpu.max", CpuMax))
+				{
+					continue;
+				}
+
+				std::istringstream Stream(CpuMax);
+				std::string Quota;
+				float Period = 0.f;
+				Stream >> Quota >> Period;
+				if (Quota == "max" || Period <= 0.f)
+				{
+					return 0.f;
+				}
+				return std::stof(Quota) / Period;
+			}
+		}
+
+		// cgroup v1
+		for (const char* Dir : { "/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct" })
+		{
+			const int Quota = ReadInt(std::string(Dir) + "/cpu.cfs_quota_us", -1);
+			const int Period = ReadInt(std::string(Dir) + "/cpu.cfs_period_us", 0);
+			if (Quota > 0 && Period > 0)
+			{
+				return static_cast<float>(Quota) / static_cast<float>(Period);
+			}
+		}
+		return 0.f;
+	}
+
+	void QueryTopology(CpuTopology& OutTopology)
+	{
+		cpu_set_t Affinity;
+		CPU_ZERO(&Affinity);
+		if (sched_getaffinity(0, sizeof(Affinity), &Affinity) != 0)
+		{
+			YIKES("Failed to read the process CPU affinity.");
+			return;
+		}
+
+		// Group the allowed processors by (package, core), SMT siblings share both ids
+		std::map<std::pair<int, int>, std::vector<int>> Cores;
+		for (int Processor = 0; Processor < CPU_SETSIZE; ++Processor)
+		{
+			if (!CPU_ISSET(Processor, &Affinity))
+			{
+				continue;
+			}
+
+			const std::string TopologyDir = "/sys/devices/system/cpu/cpu" + std::to_string(Processor) + "/topology/";
+			const int Package = ReadInt(TopologyDir + "physical_package_id", 0);
+			// Without topology info every processor is treated as its own core
+			const int Core = ReadInt(TopologyDir + "core_id", -1 - Processor);
+			Cores[{ Package, Core }].push_back(Processor);
+		}
+
+		std::vector<int> Siblings;
+		for (const auto& It : Cores)
+		{
+			OutTopology.Processors.push_back(It.second.front());
+			Siblings.insert(Siblings.end(), It.second.begin() + 1, It.second.end());
+		}
+		OutTopology.PhysicalCount = static_cast<int>(OutTopology.Processors.size());
+		OutTopology.Processors.insert(OutTopology.Processors.end(), Siblings.begin(), Siblings.end());
+		OutTopology.LogicalCount = static_cast<int>(OutTopology.Processors.size());
+		OutTopology.QuotaCores = ReadCgroupQuota();
+	}
+#endif
+
+	const CpuTopology& GetCpuTopology()
+	{
+		static const CpuTopology Topology = [] {
+			CpuTopology Out;
+#if ME_PLATFORM_LINUX
+			QueryTopology(Out);
+#elif ME_PLATFORM_UWP || ME_PLATFORM_WIN64
+			Out.PhysicalCount = GetPhysicalProcessorCount();
+#endif
+			if (Out.LogicalCount <= 0)
+			{
+				Out.LogicalCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+			}
+			if (Out.PhysicalCount <= 0)
+			{
+				Out.PhysicalCount = Out.LogicalCount;
+			}
+			return Out;
+		}();
+		return Topology;
+	}
+
+#if !(ME_PLATFORM_UWP || ME_PLATFORM_WIN64)
+	int GetPhysicalProcessorCount()
+	{
+		return GetCpuTopology().PhysicalCount;
+	}
+#endif
+
 	int GetMaxBurstThreads()
 	{
 		int ThreadCount = 0;
@@ -127,7 +268,46 @@ namespace Burst
 		ThreadCount = std::max(ThreadCount, 1);
 		return ThreadCount;
 	}
+
+	bool PinCurrentThread(int InProcessor)
+	{
+#if ME_PLATFORM_LINUX
+		if (InProcessor < 0 || InProcessor >= CPU_SETSIZE)
+		{
+			return false;
+		}
+
+		cpu_set_t Affinity;
+		CPU_ZERO(&Affinity);
+		CPU_SET(InProcessor, &Affinity);
+		return pthread_setaffinity_np(pthread_self(), sizeof(Affinity), &Affinity) == 0;
+#elif ME_PLATFORM_WIN64
+		if (InProcessor < 0 || InProcessor >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+		{
+			return false;
+		}
+		return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << InProcessor) != 0;
+#else
+		return false;
 #endif
+	}
+
+	std::size_t GetChunkCount(std::size_t InCount, std::size_t InGrainSize, std::size_t InWorkerCount)
+	{
+		if (InCount == 0)
+		{
+			return 0;
+		}
+		if (InWorkerCount <= 1)
+		{
+			return 1;
+		}
+
+		const std::size_t grainSize = std::max<std::size_t>(InGrainSize, 1);
+		const std::size_t chunksByGrain = InCount / grainSize;
+		const std::size_t chunksByWorkers = InWorkerCount * kChunksPerWorker;
+		return std::clamp<std::size_t>(std::min(chunksByGrain, chunksByWorkers), 1, kMaxParallelChunks);
+	}
 
 	void GenerateChunks(std::size_t size, std::size_t num, std::vector<std::pair<int, int>>& OutChunks)
 	{
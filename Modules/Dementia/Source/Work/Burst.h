@@ -1,7 +1,9 @@
 #pragma once
 #include "Dementia.h"
+#include "JobEngine.h"
 
 #include <functional>
+#include <vector>
 #include <assert.h>
 
 #if ME_PLATFORM_UWP || ME_PLATFORM_WIN64
@@ -11,10 +13,113 @@
 static const int kMaxBurstThreads = 32;
 namespace Burst
 {
-#if ME_PLATFORM_UWP || ME_PLATFORM_WIN64
+	struct CpuTopology
+	{
+		// Logical processors this process may run on
+		int LogicalCount = 0;
+		// Physical cores among them, SMT siblings count once
+		int PhysicalCount = 0;
+		// Logical processors in pinning order, the first SMT sibling of every core followed by the remaining siblings.
+		// Empty where the OS doesn't tell us.
+		std::vector<int> Processors;
+		// CPU time the process is allowed in cores (cgroup quota), 0 when unlimited
+		float QuotaCores = 0.f;
+	};
+
+	// Queried once. Linux reads sched_getaffinity, sysfs and the cgroup cpu quota, other platforms fill what they can
+	// and fall back to std::thread::hardware_concurrency.
+	const CpuTopology& GetCpuTopology();
+
 	int GetPhysicalProcessorCount();
 	int GetMaxBurstThreads();
-#endif
+
+	// Binds the calling thread to one logical processor, returns false where pinning isn't supported
+	bool PinCurrentThread(int InProcessor);
 
 	void GenerateChunks(std::size_t size, std::size_t num, std::vector<std::pair<int, int>>& OutChunks);
+
+	// A few chunks per worker so uneven chunks even out without the job overhead of going finer
+	static constexpr std::size_t kChunksPerWorker = 4;
+	// ParallelReduce keeps one partial result per chunk on the stack
+	static constexpr std::size_t kMaxParallelChunks = kMaxBurstThreads * kChunksPerWorker;
+
+	// How many chunks InCount items are split into, never fewer than InGrainSize items each.
+	// 1 means the range isn't worth splitting and should run inline.
+	std::size_t GetChunkCount(std::size_t InCount, std::size_t InGrainSize, std::size_t InWorkerCount);
+
+	// Splits [InBegin, InEnd) into GetChunkCount chunks and calls InFunc(ChunkIndex, Begin, End) for each of them,
+	// spread over the job engine. The calling thread takes the first chunk itself and returns once all of them ran.
+	// Jobs come from the calling worker's pool, nothing is allocated. Returns the chunk count.
+	template<typename Func>
+	std::size_t ParallelForChunks(JobEngine& InJobEngine, std::size_t InBegin, std::size_t InEnd, std::size_t InGrainSize, Func&& InFunc);
+
+	// Calls InFunc(Begin, End) on disjoint sub ranges covering [InBegin, InEnd), InFunc must be safe to call concurrently.
+	// InGrainSize is the smallest range worth a job, derive it from the cost per item: cheap items want thousands.
+	// Runs inline when the range fits in one grain, there's a single worker or the caller isn't a worker thread.
+	template<typename Func>
+	void ParallelFor(JobEngine& InJobEngine, std::size_t InBegin, std::size_t InEnd, std::size_t InGrainSize, Func&& InFunc);
+
+	// InFunc(Begin, End) returns the result for one sub range, the partial results are folded with InCombine in range order
+	// starting from InIdentity. The result only depends on the chunk count, not on which worker ran what.
+	template<typename T, typename Func, typename CombineFunc>
+	T ParallelReduce(JobEngine& InJobEngine, std::size_t InBegin, std::size_t InEnd, std::size_t InGrainSize, const T& InIdentity, Func&& InFunc, CombineFunc&& InCombine);
 };
+
+template<typename Func>
+std::size_t Burst::ParallelForChunks(JobEngine& InJobEngine, std::size_t InBegin, std::size_t InEnd, std::size_t InGrainSize, Func&& InFunc)
+{
+	const std::size_t count = (InEnd > InBegin) ? InEnd - InBegin : 0;
+	Worker* worker = InJobEngine.GetThreadWorker();
+	const std::size_t chunkCount = GetChunkCount(count, InGrainSize, worker ? InJobEngine.GetWorkerCount() : 1);
+	if (chunkCount <= 1)
+	{
+		if (count > 0)
+		{
+			InFunc(std::size_t(0), InBegin, InEnd);
+		}
+		return chunkCount;
+	}
+
+	Job* rootJob = worker->GetPool().CreateClosureJob([](Job&) {
+	});
+
+	// Chunk i covers [count * i / chunkCount, count * (i + 1) / chunkCount), sizes differ by one item at most
+	for (std::size_t i = 1; i < chunkCount; ++i)
+	{
+		const std::size_t begin = InBegin + count * i / chunkCount;
+		const std::size_t end = InBegin + count * (i + 1) / chunkCount;
+		Job* chunkJob = worker->GetPool().CreateClosureJobAsChild([&InFunc, i, begin, end](Job&) {
+			InFunc(i, begin, end);
+		}, rootJob);
+		worker->Submit(chunkJob);
+	}
+	worker->Submit(rootJob);
+
+	InFunc(std::size_t(0), InBegin, InBegin + count / chunkCount);
+	worker->Wait(rootJob);
+	return chunkCount;
+}
+
+template<typename Func>
+void Burst::ParallelFor(JobEngine& InJobEngine, std::size_t InBegin, std::size_t InEnd, std::size_t InGrainSize, Func&& InFunc)
+{
+	ParallelForChunks(InJobEngine, InBegin, InEnd, InGrainSize, [&InFunc](std::size_t InChunk, std::size_t InChunkBegin, std::size_t InChunkEnd) {
+		InFunc(InChunkBegin, InChunkEnd);
+	});
+}
+
+template<typename T, typename Func, typename CombineFunc>
+T Burst::ParallelReduce(JobEngine& InJobEngine, std::size_t InBegin, std::size_t InEnd, std::size_t InGrainSize, const T& InIdentity, Func&& InFunc, CombineFunc&& InCombine)
+{
+	T partials[kMaxParallelChunks];
+	const std::size_t chunkCount = ParallelForChunks(InJobEngine, InBegin, InEnd, InGrainSize, [&partials, &InFunc](std::size_t InChunk, std::size_t InChunkBegin, std::size_t InChunkEnd) {
+		partials[InChunk] = InFunc(InChunkBegin, InChunkEnd);
+	});
+
+	T result = InIdentity;
+	for (std::size_t i = 0; i < chunkCount; ++i)
+	{
+		result = InCombine(result, partials[i]);
+	}
+	return result;
+}
@@ -0,0 +1,89 @@
+#include "InjectionQueue.h"
+
+InjectionQueue::InjectionQueue(std::size_t InMaxJobs)
+	: EnqueuePos(0)
+	, DequeuePos(0)
+{
+	std::size_t capacity = 2;
+	while (capacity < InMaxJobs)
+	{
+		capacity <<= 1;
+	}
+
+	Cells.reset(new Cell[capacity]);
+	Mask = capacity - 1;
+	for (std::size_t i = 0; i < capacity; ++i)
+	{
+		Cells[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool InjectionQueue::Push(Job* InJob)
+{
+	Cell* cell = nullptr;
+	std::size_t pos = EnqueuePos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		cell = &Cells[pos & Mask];
+		const std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+		const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+		if (diff == 0)
+		{
+			if (EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			// The slot still holds a job from the previous lap
+			return false;
+		}
+		else
+		{
+			pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->Data = InJob;
+	cell->Sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+Job* InjectionQueue::Pop()
+{
+	Cell* cell = nullptr;
+	std::size_t pos = DequeuePos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		cell = &Cells[pos & Mask];
+		const std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+		const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+		if (diff == 0)
+		{
+			if (DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			// Nothing written to this slot yet
+			return nullptr;
+		}
+		else
+		{
+			pos = DequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	Job* job = cell->Data;
+	// Free the slot for the writer one lap ahead
+	cell->Sequence.store(pos + Mask + 1, std::memory_order_release);
+	return job;
+}
+
+bool InjectionQueue::Empty() const
+{
+	return DequeuePos.load(std::memory_order_acquire) >= EnqueuePos.load(std::memory_order_acquire);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class Job;
+
+// Bounded lock free multi producer multi consumer queue, shared by every worker of a JobEngine.
+// Takes jobs submitted from threads that don't own a worker and jobs that didn't fit in a worker's deque.
+// Every slot carries a sequence number that says whether it's ready to be written or read for the current lap.
+class InjectionQueue
+{
+public:
+	// Rounded up to a power of two
+	InjectionQueue(std::size_t InMaxJobs);
+
+	// Returns false when the queue is full
+	bool Push(Job* InJob);
+	Job* Pop();
+	bool Empty() const;
+
+private:
+	struct Cell
+	{
+		std::atomic<std::size_t> Sequence;
+		Job* Data = nullptr;
+	};
+
+	std::unique_ptr<Cell[]> Cells;
+	std::size_t Mask = 0;
+	alignas(64) std::atomic<std::size_t> EnqueuePos;
+	alignas(64) std::atomic<std::size_t> DequeuePos;
+};
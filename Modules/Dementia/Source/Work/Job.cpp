@@ -4,6 +4,7 @@ Job::Job(void(*jobFunction)(Job&), Job* parent /*= nullptr*/)
 	: JobFuntion{ jobFunction }
 	, ParentJob{ parent }
 	, UnfinishedJobs{ 1 }
+	, InUse{ 1 }
 {
 	if (ParentJob)
 	{
@@ -13,17 +14,9 @@ Job::Job(void(*jobFunction)(Job&), Job* parent /*= nullptr*/)
 
 void Job::Run()
 {
-	auto jobFunc = JobFuntion;
 	if (JobFuntion)
 	{
 		JobFuntion(*this);
-
-		if (JobFuntion == jobFunc)
-		{
-			// No callback set
-			JobFuntion = nullptr;
-		}
-
 		Finish();
 	}
 }
@@ -33,6 +26,11 @@ bool Job::IsFinished() const
 	return UnfinishedJobs.load(std::memory_order_seq_cst) == 0;
 }
 
+bool Job::IsReleased() const
+{
+	return InUse.load(std::memory_order_acquire) == 0;
+}
+
 bool Job::IsLastJob()
 {
 	return UnfinishedJobs.load(std::memory_order_seq_cst) == 1;
@@ -53,21 +51,28 @@ void Job::Finish()
 {
 	if (DecrementUnfinishedChildrenJobs())
 	{
-		if (ParentJob)
+		if (FinishedCallback)
 		{
-			ParentJob->Finish();
+			FinishedCallback(*this);
 		}
 
-		if (JobFuntion)
+		// The pool may hand this slot out again as soon as it's released, nothing of it can be read after that
+		Job* parent = ParentJob;
+		InUse.store(0, std::memory_order_release);
+
+		if (parent)
 		{
-			// Finished Callback
-			JobFuntion(*this);
+			parent->Finish();
 		}
 	}
 }
 
 void Job::OnFinished(void(*jobCallback)(Job&))
 {
-	JobFuntion = jobCallback;
+	FinishedCallback = jobCallback;
 }
 
+Job* Job::GetParent() const
+{
+	return ParentJob;
+}
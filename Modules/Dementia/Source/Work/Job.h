@@ -2,6 +2,8 @@
 #include <atomic>
 #include <new>
 #include <array>
+#include <cstdint>
+#include <cstring>
 
 class Job
 {
@@ -12,6 +14,10 @@ public:
 	void Run();
 	bool IsFinished() const;
 
+	// True once Finish is completely done with the job, only then may its storage be reused.
+	// IsFinished turns true earlier, while the finished callback and parent are still being read.
+	bool IsReleased() const;
+
 	bool IsLastJob();
 	void Finish();
 private:
@@ -21,16 +27,27 @@ private:
 	void IncrementUnfinishedChildrenJobs();
 
 	Job* ParentJob = nullptr;
-	std::atomic_size_t UnfinishedJobs;
+	void(*FinishedCallback)(Job&) = nullptr;
+	std::atomic<std::uint32_t> UnfinishedJobs;
+	// Non zero from construction until Finish returns, zero initialized storage counts as released
+	std::atomic<std::uint32_t> InUse;
 
-	static constexpr std::size_t kPayloadSize = sizeof(JobFuntion) + sizeof(ParentJob) + sizeof(UnfinishedJobs);
+	static constexpr std::size_t kPayloadSize = sizeof(JobFuntion) + sizeof(ParentJob) + sizeof(FinishedCallback) + sizeof(UnfinishedJobs) + sizeof(InUse);
     static constexpr std::size_t kMaxPaddingSize = 64;//std::hardware_destructive_interference_size;
 	static constexpr std::size_t kPaddingSize = kMaxPaddingSize - kPayloadSize;
 
 	std::array<unsigned char, kPaddingSize> Padding;
 public:
+	// Bytes available for job data, closures have to fit in here
+	static constexpr std::size_t kMaxDataSize = kPaddingSize;
+
+	// Called once the job and all of its children are done, before the parent hears about it,
+	// so jobs the callback adds as children of the parent keep the parent waiting.
+	// Closure data is already destroyed by then, data set with SetData is still readable.
 	void OnFinished(void(*jobCallback)(Job&));
 
+	Job* GetParent() const;
+
 	template <typename T, typename... Args>
 	void ConstructData(Args&&... args);
 
@@ -57,5 +74,6 @@ public:
 template <typename T, typename... Args>
 void Job::ConstructData(Args&&... args)
 {
+	static_assert(sizeof(T) <= kPaddingSize, "Job data doesn't fit, capture less or capture a pointer to it");
 	new(Padding.data()) T{ std::forward<Args>(args)... };
 }
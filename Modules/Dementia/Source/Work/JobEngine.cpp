@@ -1,36 +1,88 @@
 #include "JobEngine.h"
+#include "Burst.h"
+#include "CLog.h"
+#include "Job.h"
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <random>
 
+namespace
+{
+	JobEngineSettings MakeSettings(std::size_t InNumThreads, std::size_t InJobsPerThread)
+	{
+		JobEngineSettings settings;
+		settings.WorkerCount = InNumThreads;
+		settings.JobsPerWorker = InJobsPerThread;
+		return settings;
+	}
+
+	std::size_t ResolveWorkerCount(const JobEngineSettings& InSettings)
+	{
+		return InSettings.WorkerCount ? InSettings.WorkerCount : JobEngine::GetDefaultWorkerCount(InSettings.UseSMT);
+	}
+}
+
 JobEngine::JobEngine(std::size_t InNumThreads, std::size_t InJobsPerThread)
-	: Workers(InNumThreads)
+	: JobEngine(MakeSettings(InNumThreads, InJobsPerThread))
+{
+}
+
+JobEngine::JobEngine(const JobEngineSettings& InSettings)
+	: Workers(ResolveWorkerCount(InSettings))
+	, Injected(InSettings.JobsPerWorker)
 {
-	std::size_t jobsPerQueue = InJobsPerThread;
+	const std::size_t numThreads = ResolveWorkerCount(InSettings);
+	std::size_t jobsPerQueue = InSettings.JobsPerWorker;
 	Workers.EmplaceBack(this, jobsPerQueue, Worker::Mode::Foreground);
 
-	for (std::size_t i = 1; i < InNumThreads; ++i)
+	// The foreground thread keeps the first processor, background workers take the ones after it
+	const std::vector<int>& processors = Burst::GetCpuTopology().Processors;
+	for (std::size_t i = 1; i < numThreads; ++i)
 	{
-		Workers.EmplaceBack(this, jobsPerQueue, Worker::Mode::Background);
+		const int processor = (InSettings.PinWorkers && i < processors.size()) ? processors[i] : -1;
+		Workers.EmplaceBack(this, jobsPerQueue, Worker::Mode::Background, processor);
 	}
 
 	for (std::size_t i = 0; i < Workers.CurrentSize(); ++i)
 	{
 		Workers[i].Start();
 	}
+
+	CLog::Log(CLog::LogType::Info, "JobEngine: " + std::to_string(numThreads) + " workers" + (InSettings.PinWorkers ? ", pinned" : ""));
 }
 
 JobEngine::~JobEngine()
 {
+	for (std::size_t i = 1; i < Workers.CurrentSize(); ++i)
+	{
+		Workers[i].RequestStop();
+	}
+	NotifyAll();
+
 	for (std::size_t i = 1; i < Workers.CurrentSize(); ++i)
 	{
 		Workers[i].Stop();
 	}
 }
 
+std::size_t JobEngine::GetDefaultWorkerCount(bool InUseSMT)
+{
+	const Burst::CpuTopology& topology = Burst::GetCpuTopology();
+	int count = InUseSMT ? topology.LogicalCount : topology.PhysicalCount;
+	if (topology.QuotaCores > 0.f)
+	{
+		// More threads than the quota just get throttled at the end of each period
+		count = std::min(count, std::max(static_cast<int>(std::floor(topology.QuotaCores)), 1));
+	}
+	return static_cast<std::size_t>(std::clamp(count, 1, kMaxBurstThreads));
+}
+
 Worker* JobEngine::GetRandomWorker()
 {
+	// Seeding from random_device is a syscall, only do it once per thread
+	thread_local std::minstd_rand randomEngine{ std::random_device()() };
 	std::uniform_int_distribution<std::size_t> dist{ 0, Workers.CurrentSize()-1 };
-	std::default_random_engine randomEngine{ std::random_device()() };
 
 	Worker* worker = &Workers[dist(randomEngine)];
 
@@ -47,6 +99,24 @@ Worker* JobEngine::GetThreadWorker()
 	return FindThreadWorker(std::this_thread::get_id());
 }
 
+std::size_t JobEngine::GetWorkerCount() const
+{
+	return Workers.CurrentSize();
+}
+
+int JobEngine::GetThreadWorkerIndex() const
+{
+	const std::thread::id threadId = std::this_thread::get_id();
+	for (std::size_t i = 0; i < Workers.CurrentSize(); ++i)
+	{
+		if (Workers[i].GetThreadId() == threadId)
+		{
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
 void JobEngine::ClearWorkerPools()
 {
 	for (std::size_t i = 0; i < Workers.CurrentSize(); ++i)
@@ -56,6 +126,94 @@ void JobEngine::ClearWorkerPools()
 	}
 }
 
+void JobEngine::Inject(Job* InJob)
+{
+	if (Injected.Push(InJob))
+	{
+		return;
+	}
+
+	// Both the deque and the injection queue are full, anything queued can't drain faster than this anyway
+	ReportOverflow();
+	InJob->Run();
+}
+
+Job* JobEngine::PopInjected()
+{
+	return Injected.Pop();
+}
+
+std::size_t JobEngine::GetOverflowCount() const
+{
+	return OverflowCount.load(std::memory_order_relaxed);
+}
+
+void JobEngine::ReportOverflow()
+{
+	if (OverflowCount.fetch_add(1, std::memory_order_relaxed) == 0)
+	{
+		BRUH("JobEngine: A worker's job queue overflowed, jobs are going through the injection queue.");
+	}
+}
+
+void JobEngine::NotifyWork()
+{
+	// Orders the caller's push before the load, pairs with the increment in Park
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (ParkedWorkers.load() == 0)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(ParkMutex);
+		++WakeCount;
+	}
+	ParkCondition.notify_one();
+}
+
+void JobEngine::NotifyAll()
+{
+	{
+		std::lock_guard<std::mutex> lock(ParkMutex);
+		++WakeCount;
+	}
+	ParkCondition.notify_all();
+}
+
+void JobEngine::Park(const Worker& InWorker)
+{
+	std::unique_lock<std::mutex> lock(ParkMutex);
+	const std::uint32_t wakeCount = WakeCount;
+
+	// Submitters push before checking ParkedWorkers, so either they see us here or we see their job below
+	ParkedWorkers.fetch_add(1);
+	if (InWorker.IsRunning() && !HasQueuedJobs())
+	{
+		ParkCondition.wait(lock, [this, wakeCount, &InWorker] {
+			return WakeCount != wakeCount || !InWorker.IsRunning();
+		});
+	}
+	ParkedWorkers.fetch_sub(1);
+}
+
+bool JobEngine::HasQueuedJobs() const
+{
+	if (!Injected.Empty())
+	{
+		return true;
+	}
+
+	for (std::size_t i = 0; i < Workers.CurrentSize(); ++i)
+	{
+		if (Workers[i].HasQueuedJobs())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 Worker* JobEngine::FindThreadWorker(const std::thread::id InThreadId)
 {
 	for (std::size_t i = 0; i < Workers.CurrentSize(); ++i)
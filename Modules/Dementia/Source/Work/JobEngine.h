@@ -1,20 +1,73 @@
 #pragma once
 #include "Worker.h"
+#include "InjectionQueue.h"
 #include "StaticVector.h"
+#include <condition_variable>
+#include <mutex>
+
+struct JobEngineSettings
+{
+	// Total workers including the foreground one, 0 sizes the engine from Burst::GetCpuTopology
+	std::size_t WorkerCount = 0;
+	// Capacity of every worker's deque and of the shared injection queue
+	std::size_t JobsPerWorker = 100000;
+	// Count SMT siblings as extra cores when sizing from the topology
+	bool UseSMT = false;
+	// Bind every background worker to its own logical processor, the foreground thread is left alone
+	bool PinWorkers = false;
+};
 
 class JobEngine
 {
 public:
+	// Must be created on the thread that will run the foreground worker, it only runs jobs while waiting on them
 	JobEngine(std::size_t InNumThreads, std::size_t InJobsPerThread);
+	explicit JobEngine(const JobEngineSettings& InSettings);
 	~JobEngine();
 
 	Worker* GetRandomWorker();
 	Worker* GetThreadWorker();
 
+	std::size_t GetWorkerCount() const;
+
+	// Index of the calling thread's worker or -1 if the thread isn't owned by the engine
+	int GetThreadWorkerIndex() const;
+
 	void ClearWorkerPools();
 
+	// Queues InJob on the shared injection queue, any worker may pick it up.
+	// Used for submits from threads without a worker and for jobs that didn't fit in a worker's deque.
+	// If that is full too the job runs right here, nothing is ever dropped.
+	void Inject(Job* InJob);
+	Job* PopInjected();
+
+	// Jobs that found their worker's deque full, non zero means the engine is submitting faster than it drains
+	std::size_t GetOverflowCount() const;
+	void ReportOverflow();
+
+	// Wakes a parked background worker if there is one, called after every submit
+	void NotifyWork();
+	// Wakes every parked worker, used when stopping
+	void NotifyAll();
+
+	// Blocks InWorker's thread until NotifyWork or NotifyAll. Returns right away if a job was queued
+	// between the worker giving up on finding one and getting here, or if it's stopping.
+	void Park(const Worker& InWorker);
+
+	// Worker count for the hardware we're on, one per physical core (or logical with InUseSMT) within the cgroup quota
+	static std::size_t GetDefaultWorkerCount(bool InUseSMT);
+
 private:
 	StaticVector<Worker> Workers;
+	InjectionQueue Injected;
+	std::atomic_size_t OverflowCount = 0;
 
 	Worker* FindThreadWorker(const std::thread::id InThreadId);
+	bool HasQueuedJobs() const;
+
+	std::mutex ParkMutex;
+	std::condition_variable ParkCondition;
+	// Bumped under ParkMutex on every wake so a notify can't slip in between a worker's last check and its wait
+	std::uint32_t WakeCount = 0;
+	std::atomic_int ParkedWorkers = 0;
 };
\ No newline at end of file
@@ -2,96 +2,104 @@
 #include <algorithm>
 #include "Job.h"
 
+namespace
+{
+	std::size_t RoundUpToPowerOfTwo(std::size_t InValue)
+	{
+		std::size_t result = 1;
+		while (result < InValue)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+}
+
 JobQueue::JobQueue(std::size_t InMaxJobs)
-	: Jobs{ InMaxJobs }
-	, Bottom(0)
+	: Jobs(RoundUpToPowerOfTwo(std::max<std::size_t>(InMaxJobs, 2)))
 	, Top(0)
+	, Bottom(0)
 {
-
+	Mask = Jobs.size() - 1;
 }
 
 bool JobQueue::Push(Job* InJob)
 {
-	std::size_t bottom = Bottom.load(std::memory_order_acquire);
-
-	if (bottom < Jobs.size())
-	{
-		Jobs[bottom % Jobs.size()] = InJob;
-
-		std::atomic_thread_fence(std::memory_order_release);
-
-		Bottom.store(bottom + 1, std::memory_order_release);
-
-		return true;
-	}
-	else
+	const std::int64_t bottom = Bottom.load(std::memory_order_relaxed);
+	const std::int64_t top = Top.load(std::memory_order_acquire);
+	if (bottom - top >= static_cast<std::int64_t>(Jobs.size()))
 	{
 		return false;
 	}
+
+	Jobs[bottom & Mask].store(InJob, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Bottom.store(bottom + 1, std::memory_order_relaxed);
+	return true;
 }
 
 Job* JobQueue::Pop()
 {
-	std::size_t bottom = Bottom.load(std::memory_order_acquire);
-	if (bottom > 0)
+	// Claim the bottom slot first, then see whether a stealer got to it
+	const std::int64_t bottom = Bottom.load(std::memory_order_relaxed) - 1;
+	Bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t top = Top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
 	{
-		bottom = bottom - 1;
-		Bottom.store(bottom, std::memory_order_release);
+		// Empty
+		Bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
 	}
 
-	std::atomic_thread_fence(std::memory_order_release);
-
-	std::size_t top = Top.load(std::memory_order_acquire);
-
-	if (top <= bottom)
+	Job* job = Jobs[bottom & Mask].load(std::memory_order_relaxed);
+	if (top == bottom)
 	{
-		Job* job = Jobs[bottom % Jobs.size()];
-		if (top == bottom)
+		// Last job, race the stealers for it through Top
+		if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
 		{
-			std::size_t expectedTop = top;
-			const std::size_t nextTop = top + 1;
-			std::size_t desiredTop = nextTop;
-			if (!Top.compare_exchange_strong(expectedTop, desiredTop, std::memory_order_acq_rel))
-			{
-				// Job was stolen already
-				return nullptr;
-			}
-
-			Bottom.store(nextTop, std::memory_order_release);
+			job = nullptr;
 		}
-		return job;
-	}
-	else
-	{
-		Bottom.store(top, std::memory_order_release);
-		return nullptr;
+		Bottom.store(bottom + 1, std::memory_order_relaxed);
 	}
+	return job;
 }
 
 Job* JobQueue::Steal()
 {
-	std::size_t top = Top.load(std::memory_order_acquire);
-
-	std::atomic_thread_fence(std::memory_order_acquire);
-	
-	std::size_t bottom = Bottom.load(std::memory_order_acquire);
-	if (top < bottom)
+	std::int64_t top = Top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const std::int64_t bottom = Bottom.load(std::memory_order_acquire);
+	if (top >= bottom)
 	{
-		Job* job = Jobs[top % Jobs.size()];
-		const std::size_t nextTop = top + 1;
-		std::size_t desiredTop = nextTop;
-
-		if (!Top.compare_exchange_weak(top, desiredTop, std::memory_order_acq_rel))
-		{
-			return nullptr;
-		}
-
-		return job;
+		return nullptr;
 	}
-	else
+
+	Job* job = Jobs[top & Mask].load(std::memory_order_relaxed);
+	if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
 	{
+		// Lost against another stealer or the owner
 		return nullptr;
 	}
+	return job;
+}
+
+std::size_t JobQueue::Size() const
+{
+	const std::int64_t bottom = Bottom.load(std::memory_order_acquire);
+	const std::int64_t top = Top.load(std::memory_order_acquire);
+	return (bottom > top) ? static_cast<std::size_t>(bottom - top) : 0;
+}
+
+bool JobQueue::Empty() const
+{
+	return Size() == 0;
+}
+
+std::size_t JobQueue::Capacity() const
+{
+	return Jobs.size();
 }
 
 void JobQueue::Clear()
@@ -1,24 +1,35 @@
 #pragma once
 #include <vector>
 #include <atomic>
+#include <cstdint>
 
 class Job;
 
+// Chase-Lev work stealing deque on a fixed ring buffer.
+// The owning worker pushes and pops at the bottom, any other thread steals from the top.
+// Top and Bottom only ever grow, slots are picked with a mask so the buffer is reused as jobs drain.
 class JobQueue
 {
 public:
+	// Rounded up to a power of two
 	JobQueue(std::size_t InMaxJobs);
 
+	// Owner only. Returns false when the ring is full, the job was not queued.
 	bool Push(Job* InJob);
 
+	// Owner only
 	Job* Pop();
 	Job* Steal();
 	std::size_t Size() const;
 	bool Empty() const;
+	std::size_t Capacity() const;
+	// Only safe while no thread is using the queue
 	void Clear();
 
 private:
-	std::vector<Job*> Jobs;
-	std::atomic_size_t Top;
-	std::atomic_size_t Bottom;
+	std::vector<std::atomic<Job*>> Jobs;
+	std::size_t Mask = 0;
+	// Stealers hammer Top, keep it off the owner's cache line
+	alignas(64) std::atomic<std::int64_t> Top;
+	alignas(64) std::atomic<std::int64_t> Bottom;
 };
\ No newline at end of file
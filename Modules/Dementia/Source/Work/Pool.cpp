@@ -1,4 +1,8 @@
 #include "Pool.h"
+#include "CLog.h"
+#include <algorithm>
+#include <assert.h>
+#include <thread>
 
 Pool::Pool(std::size_t InMaxJobs)
 	: AllocatedJobs(0)
@@ -8,11 +12,37 @@ Pool::Pool(std::size_t InMaxJobs)
 
 Job* Pool::Allocate()
 {
-	if (!IsFull())
+	// Jobs don't outlive the frame that made them, once the storage is used up start over from the front
+	if (IsFull())
 	{
-		return &Storage[AllocatedJobs++];
+		AllocatedJobs = 0;
+		Spilled.erase(std::remove_if(Spilled.begin(), Spilled.end(), [](const std::unique_ptr<Job>& InJob) {
+			return InJob->IsReleased();
+		}), Spilled.end());
 	}
-	return nullptr;
+
+	Job* job = &Storage[AllocatedJobs];
+
+	// Done but another thread is still in its Finish, that only takes as long as the finished callback
+	while (job->IsFinished() && !job->IsReleased())
+	{
+		std::this_thread::yield();
+	}
+
+	if (!job->IsReleased())
+	{
+		assert(false && "Pool: Reusing a job that hasn't finished, raise JobsPerWorker");
+		if (!HasReportedSpill)
+		{
+			HasReportedSpill = true;
+			BRUH("Pool: Ran out of jobs, spilling to the heap. Raise JobsPerWorker.");
+		}
+		Spilled.push_back(std::make_unique<Job>());
+		return Spilled.back().get();
+	}
+
+	++AllocatedJobs;
+	return job;
 }
 
 bool Pool::IsFull() const
@@ -25,22 +55,22 @@ void Pool::Clear()
 	AllocatedJobs = 0;
 }
 
+std::size_t Pool::GetSpilledCount() const
+{
+	return Spilled.size();
+}
+
 Job* Pool::CreateJob(JobFunc InJobFunc)
 {
 	Job* job = Allocate();
-
-	if (job)
-	{
-		new(job) Job{ InJobFunc };
-		return job;
-	}
-
-	return nullptr;
+	new(job) Job{ InJobFunc };
+	return job;
 }
 
 Job* Pool::CreateJobAsChild(JobFunc InJobFunc, Job* InParent)
 {
-
-	return nullptr;
+	Job* job = Allocate();
+	new(job) Job{ InJobFunc, InParent };
+	return job;
 }
 
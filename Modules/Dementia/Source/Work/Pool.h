@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <vector>
 
 #include "Job.h"
@@ -10,6 +11,9 @@ class Pool
 public:
 	Pool(std::size_t InMaxJobs);
 
+	// Hands out the next slot, wrapping around to the front once the storage is used up.
+	// Wrapping onto a job that hasn't been released means more jobs are alive than the pool holds:
+	// debug builds assert, release builds hand out a heap allocated job instead and log it once.
 	Job* Allocate();
 	bool IsFull() const;
 	void Clear();
@@ -27,23 +31,31 @@ public:
 	template<typename Function>
 	Job* CreateClosureJobAsChild(Function InJobFunc, Job* InParent);
 
+	// Jobs that had to be allocated on the heap because the pool was exhausted
+	std::size_t GetSpilledCount() const;
+
 private:
 	std::size_t AllocatedJobs;
 	std::vector<Job> Storage;
+
+	std::vector<std::unique_ptr<Job>> Spilled;
+	bool HasReportedSpill = false;
 };
 
 template<typename Data>
 Job* Pool::CreateJob(JobFunc InJobFunc, const Data& InData)
 {
-
-	return nullptr;
+	Job* job = Allocate();
+	new(job) Job{ InJobFunc, InData };
+	return job;
 }
 
 template<typename Data>
 Job* Pool::CreateJobAsChild(JobFunc InJobFunc, const Data& InData, Job* InParent)
 {
-
-	return nullptr;
+	Job* job = Allocate();
+	new(job) Job{ InJobFunc, InData, InParent };
+	return job;
 }
 
 template<typename Function>
@@ -1,23 +1,45 @@
 #pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
 
+// Fixed capacity array of elements that are constructed in place and never move.
+// Storage honours alignof(T), Worker is cache line aligned.
 template<typename T>
 class StaticVector
 {
 public:
 	StaticVector() = delete;
 	StaticVector(std::size_t InSize)
-		: Count(InSize * sizeof(T))
+		: Count(InSize)
 		, End(0)
 	{
-		Vector.resize(Count);
+		Storage = static_cast<T*>(::operator new(Count * sizeof(T), std::align_val_t(alignof(T))));
 	}
 
+	~StaticVector()
+	{
+		while (End > 0)
+		{
+			Storage[--End].~T();
+		}
+		::operator delete(Storage, std::align_val_t(alignof(T)));
+	}
+
+	StaticVector(const StaticVector&) = delete;
+	StaticVector& operator=(const StaticVector&) = delete;
+
 	T& operator[](std::size_t i)
 	{
-		return *reinterpret_cast<T*>(&Vector[sizeof(T) * i]);
+		return Storage[i];
 	}
 
-	std::size_t CurrentSize()
+	const T& operator[](std::size_t i) const
+	{
+		return Storage[i];
+	}
+
+	std::size_t CurrentSize() const
 	{
 		return End;
 	}
@@ -29,13 +51,13 @@ public:
 	template<typename... Args>
 	T& EmplaceBack(Args&&... args)
 	{
-		T* ele = reinterpret_cast<T*>(&Vector[sizeof(T) * End++]);
-		new(ele) T{ std::forward<Args>(args)... };
+		T* ele = new(&Storage[End]) T{ std::forward<Args>(args)... };
+		++End;
 		return *ele;
 	}
 
 private:
-	std::vector<char> Vector;
-	std::size_t End;
+	T* Storage = nullptr;
 	std::size_t Count;
-};
\ No newline at end of file
+	std::size_t End;
+};
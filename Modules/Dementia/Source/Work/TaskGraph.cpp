@@ -0,0 +1,157 @@
+#include "TaskGraph.h"
+#include "CLog.h"
+#include "Job.h"
+#include "JobEngine.h"
+#include "optick.h"
+
+TaskGraph::TaskId TaskGraph::AddTask(const std::string& InName, TaskFunc InFunc)
+{
+	Task& NewTask = Tasks.emplace_back();
+	NewTask.Name = InName;
+	NewTask.Func = std::move(InFunc);
+	IsOrderDirty = true;
+	return Tasks.size() - 1;
+}
+
+void TaskGraph::AddDependency(TaskId InBefore, TaskId InAfter)
+{
+	if (InBefore >= Tasks.size() || InAfter >= Tasks.size() || InBefore == InAfter)
+	{
+		YIKES("TaskGraph: Invalid dependency.");
+		return;
+	}
+
+	Tasks[InBefore].Successors.push_back(InAfter);
+	Tasks[InAfter].PredecessorCount++;
+	IsOrderDirty = true;
+}
+
+void TaskGraph::Run(JobEngine& InJobEngine)
+{
+	OPTICK_EVENT("TaskGraph::Run");
+	if (IsOrderDirty)
+	{
+		RebuildOrder();
+	}
+
+	if (HasCycle)
+	{
+		YIKES("TaskGraph: The dependencies form a cycle, nothing was run.");
+		return;
+	}
+
+	Worker* worker = InJobEngine.GetThreadWorker();
+	if (!worker || Tasks.size() < 2)
+	{
+		for (TaskId Id : Order)
+		{
+			Job InlineJob{ nullptr };
+			Tasks[Id].Func(InlineJob);
+		}
+		return;
+	}
+
+	for (Task& Current : Tasks)
+	{
+		Current.PendingPredecessors.store(Current.PredecessorCount, std::memory_order_relaxed);
+	}
+
+	ActiveEngine = &InJobEngine;
+	RootJob = worker->GetPool().CreateClosureJob([](Job&) {
+	});
+
+	// Every task job is a child of RootJob, continuations are added before their predecessor reports back,
+	// so RootJob only finishes once the last task did
+	for (TaskId Id = 0; Id < Tasks.size(); ++Id)
+	{
+		if (Tasks[Id].PredecessorCount == 0)
+		{
+			Schedule(*worker, Id);
+		}
+	}
+
+	worker->Submit(RootJob);
+	worker->Wait(RootJob);
+
+	ActiveEngine = nullptr;
+	RootJob = nullptr;
+}
+
+void TaskGraph::Clear()
+{
+	Tasks.clear();
+	Order.clear();
+	IsOrderDirty = true;
+	HasCycle = false;
+}
+
+std::size_t TaskGraph::GetTaskCount() const
+{
+	return Tasks.size();
+}
+
+const std::string& TaskGraph::GetTaskName(TaskId InTask) const
+{
+	return Tasks[InTask].Name;
+}
+
+void TaskGraph::RebuildOrder()
+{
+	Order.clear();
+	Order.reserve(Tasks.size());
+
+	std::vector<std::uint32_t> Pending(Tasks.size());
+	for (TaskId Id = 0; Id < Tasks.size(); ++Id)
+	{
+		Pending[Id] = Tasks[Id].PredecessorCount;
+		if (Pending[Id] == 0)
+		{
+			Order.push_back(Id);
+		}
+	}
+
+	// Order doubles as the work list, tasks are appended once their last predecessor is placed
+	for (std::size_t i = 0; i < Order.size(); ++i)
+	{
+		for (TaskId Successor : Tasks[Order[i]].Successors)
+		{
+			if (--Pending[Successor] == 0)
+			{
+				Order.push_back(Successor);
+			}
+		}
+	}
+
+	HasCycle = Order.size() != Tasks.size();
+	IsOrderDirty = false;
+}
+
+void TaskGraph::Schedule(Worker& InWorker, TaskId InTask)
+{
+	Job* taskJob = InWorker.GetPool().CreateJobAsChild(&TaskGraph::RunTask, TaskJobData{ this, InTask }, RootJob);
+	taskJob->OnFinished(&TaskGraph::OnTaskFinished);
+	InWorker.Submit(taskJob);
+}
+
+void TaskGraph::RunTask(Job& InJob)
+{
+	const TaskJobData& Data = InJob.GetData<TaskJobData>();
+	OPTICK_EVENT("TaskGraph::RunTask");
+	Data.Graph->Tasks[Data.Task].Func(InJob);
+}
+
+void TaskGraph::OnTaskFinished(Job& InJob)
+{
+	const TaskJobData& Data = InJob.GetData<TaskJobData>();
+	TaskGraph& Graph = *Data.Graph;
+
+	// Runs on whichever worker finished the task last, its own pool and queue are the only ones it may touch
+	Worker* worker = Graph.ActiveEngine->GetThreadWorker();
+	for (TaskId Successor : Graph.Tasks[Data.Task].Successors)
+	{
+		if (Graph.Tasks[Successor].PendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Graph.Schedule(*worker, Successor);
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Job;
+class JobEngine;
+class Worker;
+
+// A set of tasks with explicit dependencies, built once and run as often as needed, typically every frame.
+// A task is handed to the job engine as soon as all of its predecessors are done, the only wait is the one in Run:
+//     TaskGraph FrameGraph;
+//     TaskGraph::TaskId Transforms = FrameGraph.AddTask("Transforms", [&](Job& InTask) { ... });
+//     TaskGraph::TaskId Culling = FrameGraph.AddTask("Culling", [&](Job& InTask) { ... });
+//     TaskGraph::TaskId Submit = FrameGraph.AddTask("Submit", [&](Job& InTask) { ... });
+//     FrameGraph.AddDependency(Transforms, Culling);
+//     FrameGraph.AddDependency(Culling, Submit);
+//     FrameGraph.Run(GetEngine().GetJobEngine());
+// A task gets its own job, jobs it starts as children of that one are waited on by its successors as well:
+//     Worker* worker = GetEngine().GetJobEngine().GetThreadWorker();
+//     worker->Submit(worker->GetPool().CreateClosureJobAsChild([](Job& InJob) { ... }, &InTask));
+class TaskGraph
+{
+public:
+	typedef std::size_t TaskId;
+
+	TaskGraph() = default;
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+	typedef std::function<void(Job&)> TaskFunc;
+
+	TaskId AddTask(const std::string& InName, TaskFunc InFunc);
+
+	// InAfter won't start before InBefore and everything it spawned is finished
+	void AddDependency(TaskId InBefore, TaskId InAfter);
+
+	// Runs every task once and returns when all of them are done.
+	// Falls back to running the tasks in dependency order on the calling thread if it isn't a worker,
+	// tasks then get a stand-in job and have no worker to start jobs on.
+	void Run(JobEngine& InJobEngine);
+
+	void Clear();
+
+	std::size_t GetTaskCount() const;
+	const std::string& GetTaskName(TaskId InTask) const;
+
+private:
+	struct Task
+	{
+		std::string Name;
+		TaskFunc Func;
+		std::vector<TaskId> Successors;
+		std::uint32_t PredecessorCount = 0;
+		// Counts down during a run, the task is scheduled when it reaches zero
+		std::atomic<std::uint32_t> PendingPredecessors = 0;
+	};
+
+	// Deque so tasks never move, their counters are shared between threads
+	std::deque<Task> Tasks;
+	// Topological order, used to validate the graph and for the serial fallback
+	std::vector<TaskId> Order;
+	bool IsOrderDirty = true;
+	bool HasCycle = false;
+
+	// Valid while Run is executing
+	JobEngine* ActiveEngine = nullptr;
+	Job* RootJob = nullptr;
+
+	struct TaskJobData
+	{
+		TaskGraph* Graph;
+		TaskId Task;
+	};
+
+	void RebuildOrder();
+	void Schedule(Worker& InWorker, TaskId InTask);
+
+	static void RunTask(Job& InJob);
+	static void OnTaskFinished(Job& InJob);
+};
@@ -1,14 +1,33 @@
 #include "Worker.h"
 #include "Job.h"
 #include "JobEngine.h"
+#include "Burst.h"
 #include <optick.h>
 #include <CLog.h>
 
-Worker::Worker(JobEngine* engine, std::size_t InMaxJobs, Mode InMode /*= Mode::Background*/)
+#if defined(_M_X64) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	// Tells the core we're spinning, lets an SMT sibling run and saves power
+	inline void CpuRelax()
+	{
+#if defined(_M_X64) || defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(__aarch64__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+}
+
+Worker::Worker(JobEngine* engine, std::size_t InMaxJobs, Mode InMode /*= Mode::Background*/, int InProcessor /*= -1*/)
 	: WorkPool(InMaxJobs)
 	, queue(InMaxJobs)
 	, ThreadMode(InMode)
 	, jobEngine(engine)
+	, Processor(InProcessor)
 {
 }
 
@@ -27,13 +46,35 @@ void Worker::Start()
 	{
 		WorkerThread = std::thread([this] {
 			OPTICK_THREAD("Burst Thread");
+			if (Processor >= 0 && !Burst::PinCurrentThread(Processor))
+			{
+				BRUH("Failed to pin a worker thread, it will float.");
+			}
+			int idleCount = 0;
 			while (IsRunning())
 			{
-				OPTICK_EVENT("GetJob")
 				Job* job = GetJob();
 				if (job)
 				{
 					job->Run();
+					idleCount = 0;
+					continue;
+				}
+
+				// Work usually shows up again within the frame, only sleep once it's been quiet for a while
+				if (++idleCount < kSpinCount)
+				{
+					CpuRelax();
+				}
+				else if (idleCount < kYieldCount)
+				{
+					std::this_thread::yield();
+				}
+				else
+				{
+					OPTICK_EVENT("Park");
+					jobEngine->Park(*this);
+					idleCount = 0;
 				}
 			}
 		});
@@ -41,9 +82,15 @@ void Worker::Start()
 	}
 }
 
-void Worker::Stop()
+void Worker::RequestStop()
 {
 	IsThreadRunning.store(false);
+}
+
+void Worker::Stop()
+{
+	RequestStop();
+	jobEngine->NotifyAll();
 	WorkerThread.join();
 	jobEngine = nullptr;
 }
@@ -65,35 +112,49 @@ Pool& Worker::GetPool()
 
 void Worker::Submit(Job* InJob)
 {
-	queue.Push(InJob);
+	// Only the owning thread may push to the deque, everyone else goes through the injection queue
+	if (std::this_thread::get_id() != ThreadId)
+	{
+		jobEngine->Inject(InJob);
+	}
+	else if (!queue.Push(InJob))
+	{
+		jobEngine->ReportOverflow();
+		jobEngine->Inject(InJob);
+	}
+	jobEngine->NotifyWork();
 }
 
 void Worker::Wait(Job* InJob)
 {
 	OPTICK_EVENT("Wait")
 
-	float failedAttempts = 0;
+	// Never parks, the remaining children may be running elsewhere and finish any moment
+	int idleCount = 0;
 	while (!InJob->IsFinished())
 	{
 		Job* job = GetJob();
-
 		if (job)
 		{
 			job->Run();
+			idleCount = 0;
+		}
+		else if (++idleCount < kSpinCount)
+		{
+			CpuRelax();
 		}
 		else
 		{
-			// I don't like this
-			failedAttempts++;
-			if (failedAttempts > 50)
-			{
-				InJob->Run();
-				break;
-			}
+			std::this_thread::yield();
 		}
 	}
 }
 
+bool Worker::HasQueuedJobs() const
+{
+	return !queue.Empty();
+}
+
 std::thread::id Worker::GetThreadId() const
 {
 	return ThreadId;
@@ -102,32 +163,22 @@ std::thread::id Worker::GetThreadId() const
 Job* Worker::GetJob()
 {
 	Job* job = queue.Pop();
-
-	if (job == nullptr)
+	if (job)
 	{
-		Worker* worker = jobEngine->GetRandomWorker();
-
-		if (worker && worker != this)
-		{
-			Job* stolenJob = worker->queue.Steal();
+		return job;
+	}
 
-			if (stolenJob)
-			{
-				return stolenJob;
-			}
-			else
-			{
-				std::this_thread::yield();
-				return nullptr;
-			}
-		}
-		else
-		{
-			std::this_thread::yield();
-			return nullptr;
-		}
+	job = jobEngine->PopInjected();
+	if (job)
+	{
+		return job;
 	}
 
-	return job;
+	Worker* worker = jobEngine->GetRandomWorker();
+	if (worker && worker != this)
+	{
+		return worker->queue.Steal();
+	}
+	return nullptr;
 }
 
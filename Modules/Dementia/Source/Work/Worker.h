@@ -22,16 +22,22 @@ public:
 		Stopping
 	};
 
-	Worker(class JobEngine* engine, std::size_t InMaxJobs, Mode InMode = Mode::Background);
+	// InProcessor pins the background thread to one logical processor, -1 leaves it to the OS
+	Worker(class JobEngine* engine, std::size_t InMaxJobs, Mode InMode = Mode::Background, int InProcessor = -1);
 	~Worker();
 
 	void Start();
+	// Tells the thread to exit once it's done with its current job, Stop also joins it
+	void RequestStop();
 	void Stop();
 	void Clear();
 	bool IsRunning() const;
 	Pool& GetPool();
+	// Safe from any thread, jobs submitted from other threads or past the deque's capacity go to the engine's injection queue
 	void Submit(Job* InJob);
+	// Runs queued and stolen jobs until InJob and all of its children are finished
 	void Wait(Job* InJob);
+	bool HasQueuedJobs() const;
 
 	std::thread::id GetThreadId() const;
 
@@ -44,6 +50,11 @@ private:
 	std::thread WorkerThread;
 	std::atomic<State> ThreadState;
 	std::atomic<Mode> ThreadMode;
+	int Processor = -1;
+
+	// Idle loop iterations spent spinning, then yielding, before the thread parks
+	static constexpr int kSpinCount = 64;
+	static constexpr int kYieldCount = 128;
 
 	Job* GetJob();
 	void Join();
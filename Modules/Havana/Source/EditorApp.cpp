@@ -143,7 +143,10 @@ void EditorApp::StartGame()
 {
 	if (!m_isGameRunning)
 	{
-		GetEngine().GetWorld().lock()->Start();
+		SharedPtr<World> GameWorld = GetEngine().GetWorld().lock();
+		// Leaving play mode rolls back to this instead of reloading the scene from disk
+		PlaySnapshot = GameWorld->Snapshot();
+		GameWorld->Start();
 		m_isGameRunning = true;
 	}
 }
@@ -152,11 +155,20 @@ void EditorApp::StopGame()
 {
 	if (m_isGameRunning)
 	{
-		if (GetEngine().GetWorld().lock())
+		m_isGameRunning = false;
+		SharedPtr<World> GameWorld = GetEngine().GetWorld().lock();
+		if (GameWorld && !PlaySnapshot.IsEmpty())
 		{
-			GetEngine().GetWorld().lock()->Destroy();
+			GameWorld->Stop();
+			GameWorld->Restore(PlaySnapshot);
+			PlaySnapshot.Clear();
+			return;
+		}
+
+		if (GameWorld)
+		{
+			GameWorld->Destroy();
 		}
-		m_isGameRunning = false;
 		NewSceneEvent evt;
 		evt.Fire();
 		InitialLevel = GetEngine().GetConfig().GetValue("CurrentScene");
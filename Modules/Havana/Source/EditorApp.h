@@ -2,6 +2,7 @@
 #include "Game.h"
 #include "Havana.h"
 #include "Events/EventReceiver.h"
+#include "Engine/WorldSnapshot.h"
 
 // I don't like this
 #include "../../Game/Source/ComponentRegistry.h"
@@ -42,6 +43,10 @@ public:
 	bool m_isGameRunning = false;
 	bool m_isGamePaused = false;
 	std::string InitialLevel;
+
+private:
+	// World state from when play mode was entered
+	WorldSnapshot PlaySnapshot;
 };
 
 #endif
\ No newline at end of file
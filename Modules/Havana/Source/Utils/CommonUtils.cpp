@@ -12,9 +12,9 @@ void CommonUtils::RecusiveDelete(EntityHandle ent, Transform* trans)
 	{
 		return;
 	}
-	for (auto child : trans->GetChildren())
+	for (Transform* child : trans->GetChildren())
 	{
-		RecusiveDelete(child->Parent, child.get());
+		RecusiveDelete(child->Parent, child);
 	}
 	ent->MarkForDelete();
 }
@@ -157,11 +157,11 @@ void CommonUtils::SerializeEntity(json& outEntity, Transform* CurrentTransform)
 		comp->Serialize(compJson);
 		componentsJson.push_back(compJson);
 	}
-	if (CurrentTransform->GetChildren().size() > 0)
+	if (CurrentTransform->HasChildren())
 	{
-		for (SharedPtr<Transform> Child : CurrentTransform->GetChildren())
+		for (Transform* Child : CurrentTransform->GetChildren())
 		{
-			SerializeEntity(outEntity["Children"], Child.get());
+			SerializeEntity(outEntity["Children"], Child);
 		}
 	}
 }
@@ -1067,11 +1067,11 @@ void AssetBrowserWidget::SavePrefab(json& d, Transform* CurrentTransform, bool I
 		comp->Serialize(compJson);
 		componentsJson.push_back(compJson);
 	}
-	if (CurrentTransform->GetChildren().size() > 0)
+	if (CurrentTransform->HasChildren())
 	{
-		for (SharedPtr<Transform> Child : CurrentTransform->GetChildren())
+		for (Transform* Child : CurrentTransform->GetChildren())
 		{
-			SavePrefab(newJson["Children"], Child.get(), false);
+			SavePrefab(newJson["Children"], Child, false);
 		}
 	}
 
@@ -149,7 +149,7 @@ void SceneHierarchyWidget::Render()
 						if (ImGui::IsItemClicked())
 						{
 							InspectEvent evt;
-							evt.SelectedEntity = EntityHandle(ent.GetId(), world->GetSharedPtr());
+							evt.SelectedEntity = EntityHandle(ent.GetId(), world.get());
 							evt.Fire();
 						}
 					}
@@ -217,24 +217,24 @@ void SceneHierarchyWidget::UpdateWorldRecursive(Transform* root)
 	}
 
 	int i = 0;
-	for (SharedPtr<Transform> child : root->GetChildren())
+	for (Transform* child : root->GetChildren())
 	{
 		OPTICK_CATEGORY("UpdateWorld::UpdateWorldRecursive::Child", Optick::Category::GameLogic);
 		if (!child)
 		{
 			continue;
 		}
-		Transform* var = child.get();
+		Transform* var = child;
 		bool open = false;
 		ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding | (SelectedTransform.lock().get() == var ? ImGuiTreeNodeFlags_Selected : 0);
-		if (var->GetChildren().empty())
+		if (!var->HasChildren())
 		{
 			node_flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen; // ImGuiTreeNodeFlags_Bullet
 			open = ImGui::TreeNodeEx((void*)(intptr_t)i, node_flags, var->GetName().c_str());
 			if (ImGui::IsItemClicked())
 			{
 				InspectEvent evt;
-				evt.SelectedTransform = child;
+				evt.SelectedTransform = child->shared_from_this();
 				evt.SelectedEntity = var->Parent;
 				evt.Fire();
 			}
@@ -274,7 +274,7 @@ void SceneHierarchyWidget::UpdateWorldRecursive(Transform* root)
 			if (ImGui::IsItemClicked())
 			{
 				InspectEvent evt;
-				evt.SelectedTransform = child;
+				evt.SelectedTransform = child->shared_from_this();
 				evt.SelectedEntity = var->Parent;
 				evt.Fire();
 			}
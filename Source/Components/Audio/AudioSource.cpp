@@ -122,6 +122,25 @@ void AudioSource::OnDeserialize(const json& inJson)
 	}
 }
 
+void AudioSource::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(FilePath.LocalPath);
+	Out.Write(PlayOnAwake);
+	Out.Write(Loop);
+}
+
+void AudioSource::LoadSnapshot(SnapshotReader& In)
+{
+	std::string SnapshotPath;
+	In.Read(SnapshotPath);
+	if (SnapshotPath != FilePath.LocalPath)
+	{
+		FilePath = Path(SnapshotPath);
+	}
+	In.Read(PlayOnAwake);
+	In.Read(Loop);
+}
+
 #if ME_EDITOR
 void AudioSource::OnEditorInspect()
 {
@@ -51,6 +51,9 @@ private:
 	virtual void OnSerialize(json& outJson) final;
 	virtual void OnDeserialize(const json& inJson) final;
 
+	virtual void SaveSnapshot(SnapshotWriter& Out) final;
+	virtual void LoadSnapshot(SnapshotReader& In) final;
+
 #ifdef FMOD_ENABLED
 	FMOD::System* m_owner = nullptr;
 #endif
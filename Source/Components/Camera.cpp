@@ -165,6 +165,48 @@ void Camera::OnSerialize(json& outJson)
 	outJson["ClearColor"] = { ClearColor.x, ClearColor.y, ClearColor.z };
 }
 
+std::string Camera::GetSkyboxPath() const
+{
+	const Moonlight::Texture* SkyTexture = (Skybox && Skybox->SkyMaterial) ? Skybox->SkyMaterial->GetTexture(Moonlight::TextureType::Diffuse) : nullptr;
+	return SkyTexture ? SkyTexture->GetPath().LocalPath : std::string();
+}
+
+void Camera::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(Zoom);
+	Out.Write(IsCurrent());
+	Out.Write(Near);
+	Out.Write(Far);
+	Out.Write(OrthographicSize);
+	Out.Write(Projection);
+	Out.Write(ClearType);
+	Out.Write(ClearColor.InternalVector);
+	Out.Write(GetSkyboxPath());
+}
+
+void Camera::LoadSnapshot(SnapshotReader& In)
+{
+	In.Read(Zoom);
+	if (In.Read<bool>())
+	{
+		SetCurrent();
+	}
+	In.Read(Near);
+	In.Read(Far);
+	In.Read(OrthographicSize);
+	In.Read(Projection);
+	In.Read(ClearType);
+	In.Read(ClearColor.InternalVector);
+
+	// The sky is only reloaded when it was swapped during play
+	std::string SkyboxPath;
+	In.Read(SkyboxPath);
+	if (!SkyboxPath.empty() && SkyboxPath != GetSkyboxPath())
+	{
+		Skybox = new Moonlight::SkyBox(SkyboxPath);
+	}
+}
+
 #if ME_EDITOR
 
 void Camera::OnEditorInspect()
@@ -67,5 +67,10 @@ private:
 	bool isOblique = false;
 	virtual void OnDeserialize(const json& inJson) final;
 	virtual void OnSerialize(json& outJson) final;
+
+	virtual void SaveSnapshot(SnapshotWriter& Out) final;
+	virtual void LoadSnapshot(SnapshotReader& In) final;
+
+	std::string GetSkyboxPath() const;
 };
 ME_REGISTER_COMPONENT_FOLDER(Camera, "Rendering")
@@ -26,6 +26,20 @@ void FlyingCamera::OnDeserialize(const json& inJson)
 {
 }
 
+void FlyingCamera::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(FlyingSpeed);
+	Out.Write(LookSensitivity);
+	Out.Write(SpeedModifier);
+}
+
+void FlyingCamera::LoadSnapshot(SnapshotReader& In)
+{
+	In.Read(FlyingSpeed);
+	In.Read(LookSensitivity);
+	In.Read(SpeedModifier);
+}
+
 #if ME_EDITOR
 
 void FlyingCamera::OnEditorInspect()
@@ -26,5 +26,8 @@ public:
 private:
 	void OnSerialize(json& outJson) final;
 	void OnDeserialize(const json& inJson) final;
+
+	void SaveSnapshot(SnapshotWriter& Out) final;
+	void LoadSnapshot(SnapshotReader& In) final;
 };
 ME_REGISTER_COMPONENT_FOLDER(FlyingCamera, "Misc")
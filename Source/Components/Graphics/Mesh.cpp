@@ -75,7 +75,7 @@ void Mesh::Init()
 {
 }
 
-unsigned int Mesh::GetId()
+unsigned int Mesh::GetId() const
 {
 	return Id;
 }
@@ -139,6 +139,23 @@ void Mesh::OnDeserialize(const json& inJson)
 	}
 }
 
+void Mesh::SaveSnapshot(SnapshotWriter& Out)
+{
+	// Copied so edits made while playing don't reach the snapshot
+	Out.WriteObject(MeshMaterial ? MeshMaterial->CreateInstance() : nullptr);
+	Out.Write(Type);
+}
+
+void Mesh::LoadSnapshot(SnapshotReader& In)
+{
+	// Copied again, the same snapshot can be restored more than once
+	if (SharedPtr<Moonlight::Material> SnapshotMaterial = In.ReadObject<Moonlight::Material>())
+	{
+		MeshMaterial = SnapshotMaterial->CreateInstance();
+	}
+	In.Read(Type);
+}
+
 std::string Mesh::GetMeshTypeString(Moonlight::MeshType InType)
 {
 	switch (InType)
@@ -30,7 +30,7 @@ public:
 	// Separate init from construction code.
 	virtual void Init() final;
 
-	unsigned int GetId();
+	unsigned int GetId() const;
 
 	Moonlight::MeshData* MeshReferece = nullptr;
 	SharedPtr<Moonlight::Material> MeshMaterial;
@@ -39,6 +39,10 @@ public:
 
 	virtual void OnSerialize(json& outJson) final;
 	virtual void OnDeserialize(const json& inJson) final;
+
+	// The snapshot keeps its own copy of the material, nothing is reloaded on restore
+	virtual void SaveSnapshot(SnapshotWriter& Out) final;
+	virtual void LoadSnapshot(SnapshotReader& In) final;
 private:
 	unsigned int Id = 0;
 	Moonlight::MeshType Type;
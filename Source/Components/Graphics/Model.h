@@ -41,6 +41,21 @@ private:
 		ModelPath = Path(inJson["ModelPath"]);
 	}
 
+	virtual void SaveSnapshot(SnapshotWriter& Out) final
+	{
+		Out.Write(ModelPath.LocalPath);
+	}
+
+	virtual void LoadSnapshot(SnapshotReader& In) final
+	{
+		std::string SnapshotPath;
+		In.Read(SnapshotPath);
+		if (SnapshotPath != ModelPath.LocalPath)
+		{
+			ModelPath = Path(SnapshotPath);
+		}
+	}
+
 #if ME_EDITOR
 	virtual void OnEditorInspect() final;
 #endif
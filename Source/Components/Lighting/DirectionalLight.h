@@ -69,5 +69,19 @@ private:
 			Diffuse = { (float)inJson["Diffuse"][0], (float)inJson["Diffuse"][1], (float)inJson["Diffuse"][2] };
 		}
 	}
+
+	virtual void SaveSnapshot(SnapshotWriter& Out) final
+	{
+		Out.Write(Direction.InternalVector);
+		Out.Write(Ambient.InternalVector);
+		Out.Write(Diffuse.InternalVector);
+	}
+
+	virtual void LoadSnapshot(SnapshotReader& In) final
+	{
+		In.Read(Direction.InternalVector);
+		In.Read(Ambient.InternalVector);
+		In.Read(Diffuse.InternalVector);
+	}
 };
 ME_REGISTER_COMPONENT_FOLDER(DirectionalLight, "Rendering")
@@ -22,6 +22,16 @@ void Light::OnDeserialize(const json& inJson)
 {
 }
 
+void Light::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(Colour.InternalVector);
+}
+
+void Light::LoadSnapshot(SnapshotReader& In)
+{
+	In.Read(Colour.InternalVector);
+}
+
 #if ME_EDITOR
 
 void Light::OnEditorInspect()
@@ -23,5 +23,8 @@ public:
 private:
 	void OnSerialize(json& outJson) override;
 	void OnDeserialize(const json& inJson) override;
+
+	void SaveSnapshot(SnapshotWriter& Out) override;
+	void LoadSnapshot(SnapshotReader& In) override;
 };
 ME_REGISTER_COMPONENT_FOLDER(Light, "Rendering")
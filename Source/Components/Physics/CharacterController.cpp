@@ -192,6 +192,24 @@ void CharacterController::OnDeserialize(const json& inJson)
 	}
 }
 
+void CharacterController::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(JumpForce);
+	Out.Write(MaxSpeed);
+	Out.Write(Deceleration);
+	Out.Write(JumpRechargeTime);
+	Out.Write(m_stepHeight);
+}
+
+void CharacterController::LoadSnapshot(SnapshotReader& In)
+{
+	In.Read(JumpForce);
+	In.Read(MaxSpeed);
+	In.Read(Deceleration);
+	In.Read(JumpRechargeTime);
+	In.Read(m_stepHeight);
+}
+
 #if ME_EDITOR
 
 void CharacterController::OnEditorInspect()
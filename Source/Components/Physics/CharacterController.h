@@ -78,6 +78,9 @@ private:
 
 	virtual void OnSerialize(json& outJson) final;
 	virtual void OnDeserialize(const json& inJson) final;
+
+	virtual void SaveSnapshot(SnapshotWriter& Out) final;
+	virtual void LoadSnapshot(SnapshotReader& In) final;
 };
 
 ME_REGISTER_COMPONENT_FOLDER(CharacterController, "Physics")
\ No newline at end of file
@@ -154,6 +154,24 @@ void Rigidbody::OnDeserialize(const json& inJson)
 	}
 }
 
+void Rigidbody::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(Scale.InternalVector);
+	Out.Write(Type);
+	Out.Write(Mass);
+	Out.Write(IsEventsEnabled);
+}
+
+void Rigidbody::LoadSnapshot(SnapshotReader& In)
+{
+	Vector3 SnapshotScale;
+	In.Read(SnapshotScale.InternalVector);
+	SetScale(SnapshotScale);
+	In.Read(Type);
+	In.Read(Mass);
+	In.Read(IsEventsEnabled);
+}
+
 void Rigidbody::CreateObject(const Vector3& Position, const Quaternion& Rotation, const Vector3& InScale, btDiscreteDynamicsWorld* world)
 {
 	m_world = world;
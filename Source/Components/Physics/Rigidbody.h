@@ -58,6 +58,9 @@ private:
 
 	virtual void OnSerialize(json& outJson) final;
 	virtual void OnDeserialize(const json& inJson) final;
+
+	virtual void SaveSnapshot(SnapshotWriter& Out) final;
+	virtual void LoadSnapshot(SnapshotReader& In) final;
 protected:
 	bool IsInitialized = false;
 	class btDiscreteDynamicsWorld* m_world;
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include "Math/Vector3.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Cores/SceneCore.h"
 #include "Mathf.h"
 #include "optick.h"
 #include <glm/gtc/type_ptr.hpp>
@@ -23,7 +25,7 @@ Transform::Transform()
 
 Transform::Transform(const std::string& TransformName)
 	: Component("Transform")
-	, Name(std::move(TransformName))
+	, NameId(StringTable::Get().Intern(TransformName))
 	, LocalPosition(0.f, 0.f, 0.f)
 	, LocalScale(1.0f, 1.0f, 1.0f)
 {
@@ -31,11 +33,10 @@ Transform::Transform(const std::string& TransformName)
 
 Transform::~Transform()
 {
-	if (ParentTransform)
+	if (Hierarchy)
 	{
-		ParentTransform->RemoveChild(shared_from_this().get());
+		Hierarchy->RemoveNode(*this);
 	}
-	ParentTransform = nullptr;
 }
 
 void Transform::Init()
@@ -91,7 +92,7 @@ void Transform::SetScale(float NewScale)
 
 Vector3 Transform::GetWorldPosition() const
 {
-	if (ParentTransform)
+	if (Transform* ParentTransform = GetParentTransform())
 	{
 		return ParentTransform->GetLocalToWorldMatrix().TransformPoint(GetPosition());
 	}
@@ -100,7 +101,7 @@ Vector3 Transform::GetWorldPosition() const
 
 void Transform::SetWorldPosition(const Vector3& NewPosition)
 {
-	if (ParentTransform)
+	if (Transform* ParentTransform = GetParentTransform())
 	{
 		LocalPosition = ParentTransform->GetWorldToLocalMatrix().TransformPoint(NewPosition);
 	}
@@ -114,7 +115,7 @@ void Transform::SetWorldPosition(const Vector3& NewPosition)
 
 Quaternion Transform::GetWorldRotation()
 {
-	if (ParentTransform)
+	if (Transform* ParentTransform = GetParentTransform())
 	{
 		return ParentTransform->GetWorldRotation() * GetRotation();
 	}
@@ -124,7 +125,7 @@ Quaternion Transform::GetWorldRotation()
 
 void Transform::SetWorldRotation(const Quaternion& inRotation)
 {
-	if (ParentTransform)
+	if (Transform* ParentTransform = GetParentTransform())
 	{
 		LocalRotation = ParentTransform->GetWorldRotation().Inverse() * inRotation;
 	}
@@ -206,51 +207,62 @@ void Transform::SetWorldTransform(Matrix4& NewWorldTransform, bool InIsDirty)
 
 const bool Transform::IsDirty() const
 {
-	return IsLocalToWorldDirty || IsWorldToLocalDirty;
+	if (Hierarchy)
+	{
+		return Hierarchy->IsDirtyInHierarchy(*this);
+	}
+	return IsLocalToWorldDirty;
 }
 
-const Matrix4& Transform::GetLocalToWorldMatrix()
+bool Transform::NeedsPhysicsSync() const
 {
-	if (IsLocalToWorldDirty)
-	{
-		glm::mat4 T = glm::translate(glm::mat4(1.0f), GetPosition().InternalVector);
-		glm::quat R = GetRotation().InternalQuat;
-		glm::mat4 S = glm::scale(glm::mat4(1.0f), GetScale().InternalVector);
-		glm::mat4 P = ParentTransform ? ParentTransform->GetLocalToWorldMatrix().GetInternalMatrix() : glm::mat4(1.0f);
+	return IsPhysicsSyncPending;
+}
 
-		LocalToWorldMatrix = Matrix4(P * T * glm::toMat4(R) * S);
-		IsLocalToWorldDirty = false;
+void Transform::ClearPhysicsSync()
+{
+	IsPhysicsSyncPending = false;
+}
+
+Matrix4 Transform::GetLocalToWorldMatrix() const
+{
+	// Moves aren't pushed down to children, the hierarchy knows whether anything above this one changed
+	if (Hierarchy)
+	{
+		if (Hierarchy->IsDirtyInHierarchy(*this))
+		{
+			return Hierarchy->ComputeWorldMatrix(*this).ToMatrix4();
+		}
+		return LocalToWorldMatrix;
 	}
 
+	if (IsLocalToWorldDirty)
+	{
+		return AffineMatrix::FromTRS(LocalPosition.InternalVector, LocalRotation.InternalQuat, LocalScale.InternalVector).ToMatrix4();
+	}
 	return LocalToWorldMatrix;
 }
 
-const Matrix4& Transform::GetWorldToLocalMatrix()
+Matrix4 Transform::GetWorldToLocalMatrix() const
 {
-	if (IsWorldToLocalDirty)
-	{
-		WorldToLocalMatrix = GetLocalToWorldMatrix().Inverse();
-		IsWorldToLocalDirty = false;
-	}
-	return WorldToLocalMatrix;
+	// World matrices are always affine, skip the general 4x4 inverse
+	return AffineMatrix(GetLocalToWorldMatrix()).Inverse().ToMatrix4();
 }
 
 void Transform::SetDirty(bool Dirty)
 {
 	OPTICK_EVENT("Transform::SetDirty");
-	if (Dirty && (Dirty != m_isDirty))
+	if (Dirty)
 	{
-		for (SharedPtr<Transform>& Child : Children)
+		IsPhysicsSyncPending = true;
+		MarkChanged();
+		// Children aren't visited here, SceneCore picks up the whole subtree once in its pass
+		if (Hierarchy)
 		{
-			if (Child)
-			{
-				Child->SetDirty(Dirty);
-			}
+			Hierarchy->MarkDirty(*this);
 		}
 	}
-	m_isDirty = Dirty;
 	IsLocalToWorldDirty = true;
-	IsWorldToLocalDirty = true;
 }
 
 void Transform::LookAt(const Vector3& InDirection)
@@ -302,59 +314,112 @@ Vector3 Transform::GetWorldRotationEuler()
 
 void Transform::SetParent(Transform& NewParent)
 {
-	if (ParentTransform)
+	if (SceneCore* Scene = GetHierarchy())
 	{
-		GetParentTransform()->RemoveChild(this);
+		Scene->SetParent(*this, &NewParent);
 	}
-	
-	ParentTransform = NewParent.shared_from_this();
-	GetParentTransform()->Children.push_back(shared_from_this());
 	SetDirty(true);
 }
 
 void Transform::RemoveChild(Transform* TargetTransform)
 {
-	if (Children.size() > 0)
+	if (Hierarchy && TargetTransform && TargetTransform->GetParentTransform() == this)
 	{
-		Children.erase(std::remove(Children.begin(), Children.end(), TargetTransform->shared_from_this()), Children.end());
-		TargetTransform->ParentTransform = nullptr;
+		Hierarchy->SetParent(*TargetTransform, nullptr);
+		TargetTransform->SetDirty(true);
 	}
 }
 
 Transform* Transform::GetChildByName(const std::string& Name)
 {
-	for (auto child : Children)
+	// A name that was never interned can't belong to any transform
+	const StringTable::Id Id = StringTable::Get().Find(Name);
+	if (!Hierarchy || Id == StringTable::kNotFound)
 	{
-		if (child->Name == Name)
-		{
-			return child.get();
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return Hierarchy->FindChild(*this, Id);
 }
 
-const std::vector<SharedPtr<Transform>>& Transform::GetChildren() const
+std::vector<Transform*> Transform::GetChildren() const
 {
+	std::vector<Transform*> Children;
+	if (Hierarchy)
+	{
+		Hierarchy->ForEachChild(*this, [&Children](Transform& Child) {
+			Children.push_back(&Child);
+		});
+	}
 	return Children;
 }
 
-Transform* Transform::GetParentTransform()
+bool Transform::HasChildren() const
 {
-	if (ParentTransform)
+	return Hierarchy && Hierarchy->HasChildren(*this);
+}
+
+void Transform::SetStatic(bool InIsStatic)
+{
+	if (Static == InIsStatic)
+	{
+		return;
+	}
+
+	Static = InIsStatic;
+	MarkChanged();
+	if (Hierarchy)
+	{
+		Hierarchy->RefreshFrozen(Hierarchy->GetNode(*this));
+	}
+}
+
+bool Transform::IsStatic() const
+{
+	return Static;
+}
+
+bool Transform::IsFrozen() const
+{
+	return Hierarchy && Hierarchy->IsFrozen(*this);
+}
+
+Transform* Transform::GetParentTransform() const
+{
+	return Hierarchy ? Hierarchy->GetParent(*this) : nullptr;
+}
+
+SceneCore* Transform::GetHierarchy()
+{
+	if (!Hierarchy)
 	{
-		return ParentTransform.get();
+		World* GameWorld = Parent.GetWorld();
+		if (GameWorld && GameWorld->HasCore(SceneCore::GetTypeId()))
+		{
+			return static_cast<SceneCore*>(GameWorld->GetCore(SceneCore::GetTypeId()));
+		}
 	}
-	return nullptr;
+	return Hierarchy;
 }
 
-const Matrix4& Transform::GetMatrix()
+const Matrix4& Transform::GetMatrix() const
 {
-	return GetLocalToWorldMatrix();
+	// Kept up to date by SceneCore's batched pass, transforms outside a hierarchy still compute on demand
+	if (!Hierarchy && IsLocalToWorldDirty)
+	{
+		LocalToWorldMatrix = AffineMatrix::FromTRS(LocalPosition.InternalVector, LocalRotation.InternalQuat, LocalScale.InternalVector).ToMatrix4();
+		IsLocalToWorldDirty = false;
+	}
+	return LocalToWorldMatrix;
 }
 
 const std::string& Transform::GetName() const
 {
-	return Name;
+	return StringTable::Get().GetString(NameId);
+}
+
+StringTable::Id Transform::GetNameId() const
+{
+	return NameId;
 }
 
 void Transform::OnSerialize(json& outJson)
@@ -363,6 +428,7 @@ void Transform::OnSerialize(json& outJson)
 	Vector3 outRot = Quaternion::ToEulerAngles(LocalRotation);
 	outJson["Rotation"] = { outRot.x, outRot.y, outRot.z };
 	outJson["Scale"] = { LocalScale.x, LocalScale.y, LocalScale.z };
+	outJson["Static"] = Static;
 }
 
 void Transform::OnDeserialize(const json& inJson)
@@ -373,17 +439,102 @@ void Transform::OnDeserialize(const json& inJson)
 	{
 		SetScale(Vector3((float)inJson["Scale"][0], (float)inJson["Scale"][1], (float)inJson["Scale"][2]));
 	}
+	if (inJson.find("Static") != inJson.end())
+	{
+		SetStatic(inJson["Static"]);
+	}
+}
+
+void Transform::SaveSnapshot(SnapshotWriter& Out)
+{
+	Out.Write(NameId);
+	Out.Write(LocalPosition.InternalVector);
+	Out.Write(LocalRotation.InternalQuat);
+	Out.Write(LocalScale.InternalVector);
+	Out.Write(Static);
+	Transform* ParentTransform = GetParentTransform();
+	Out.Write(ParentTransform ? ParentTransform->Parent.GetId() : EntityID());
+}
+
+void Transform::LoadSnapshot(SnapshotReader& In)
+{
+	StringTable::Id SnapshotNameId = StringTable::kEmptyId;
+	In.Read(SnapshotNameId);
+	SetNameId(SnapshotNameId);
+	In.Read(LocalPosition.InternalVector);
+	In.Read(LocalRotation.InternalQuat);
+	In.Read(LocalScale.InternalVector);
+	bool IsSnapshotStatic = false;
+	In.Read(IsSnapshotStatic);
+	SetStatic(IsSnapshotStatic);
+	In.Read(SnapshotParent);
+	SetDirty(true);
+}
+
+void Transform::OnSnapshotRestored()
+{
+	Transform* NewParent = nullptr;
+	if (!SnapshotParent.IsNull())
+	{
+		Entity* ParentEntity = Parent.GetWorld()->GetEntityRaw(SnapshotParent);
+		if (ParentEntity && ParentEntity->HasComponent<Transform>())
+		{
+			NewParent = &ParentEntity->GetComponent<Transform>();
+		}
+	}
+	SnapshotParent.Clear();
+
+	Transform* OldParent = GetParentTransform();
+	if (NewParent)
+	{
+		if (NewParent != OldParent)
+		{
+			SetParent(*NewParent);
+		}
+	}
+	else if (OldParent)
+	{
+		OldParent->RemoveChild(this);
+	}
+	SetDirty(true);
 }
 
 void Transform::SetName(const std::string& name)
 {
-	Name = name;
+	SetNameId(StringTable::Get().Intern(name));
+}
+
+void Transform::SetNameId(StringTable::Id InNameId)
+{
+	if (NameId == InNameId)
+	{
+		return;
+	}
+
+	const StringTable::Id OldNameId = NameId;
+	NameId = InNameId;
+	MarkChanged();
+	if (Hierarchy)
+	{
+		Hierarchy->OnNameChanged(*this, OldNameId);
+	}
 }
 
 void Transform::OnEditorInspect()
 {
+	std::string EditName = GetName();
 	HavanaUtils::Label("Name");
-	ImGui::InputText("##Name", &Name);
+	if (ImGui::InputText("##Name", &EditName))
+	{
+		SetName(EditName);
+	}
+
+	bool IsStaticTemp = Static;
+	HavanaUtils::Label("Static");
+	if (ImGui::Checkbox("##Static", &IsStaticTemp))
+	{
+		SetStatic(IsStaticTemp);
+	}
 
 	Vector3 OldPosition = LocalPosition;
 	if (HavanaUtils::EditableVector3("Local Position", OldPosition))
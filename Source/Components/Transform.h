@@ -7,6 +7,10 @@
 #include "Utils/HavanaUtils.h"
 #include "Math/Quaternion.h"
 #include "Math/Matrix4.h"
+#include "Math/AffineMatrix.h"
+#include "Utils/StringTable.h"
+
+class SceneCore;
 
 enum class TransformSpace : uint8_t
 {
@@ -26,6 +30,9 @@ public:
 	Transform(const std::string& Name);
 	virtual ~Transform();
 
+	// Every setter stamps the change tick, queries don't have to
+	static constexpr bool kMarksOwnChanges = true;
+
 	// Separate init from construction code.
 	virtual void Init() final;
 
@@ -67,42 +74,73 @@ public:
 	ME_NONCOPYABLE(Transform)
 	ME_NONMOVABLE(Transform)
 
+	// The hierarchy itself lives in SceneCore, these forward to it
 	void SetParent(Transform& NewParent);
 	void RemoveChild(Transform* TargetTransform);
+	// Hash lookup in the hierarchy's child name index, with duplicate names any one of the matches is returned
 	Transform* GetChildByName(const std::string& Name);
-	const std::vector<SharedPtr<Transform>>& GetChildren() const;
+	std::vector<Transform*> GetChildren() const;
+	bool HasChildren() const;
+
+	Transform* GetParentTransform() const;
 
-	Transform* GetParentTransform();
-	const Matrix4& GetMatrix();
+	// Static transforms and everything below them are frozen while the game runs: their world matrix is
+	// computed once and physics / render sync skip them. Clear the flag to move them again, edits made while frozen apply then.
+	void SetStatic(bool InIsStatic);
+	bool IsStatic() const;
+	bool IsFrozen() const;
+
+	// World matrix as of the last SceneCore pass, use GetLocalToWorldMatrix when changes made this frame have to show
+	const Matrix4& GetMatrix() const;
 
 	const std::string& GetName() const;
 	void SetName(const std::string& name);
+
+	// Names are interned in StringTable, the id is what lookups compare
+	StringTable::Id GetNameId() const;
+	void SetNameId(StringTable::Id InNameId);
 	void SetWorldTransform(Matrix4& NewWorldTransform, bool InIsDirty = false);
 
 	const bool IsDirty() const;
 
-	const Matrix4& GetLocalToWorldMatrix();
-	const Matrix4& GetWorldToLocalMatrix();
+	// Set by every move and by SceneCore when a parent moved this one, only physics clears it once the body is synced.
+	// IsDirty can't tell physics that, it only covers changes since SceneCore's pass and that runs after gameplay.
+	bool NeedsPhysicsSync() const;
+	void ClearPhysicsSync();
+
+	// Computed per call and returned by value, nothing is cached, so jobs moving several children may read the same parent at once
+	Matrix4 GetLocalToWorldMatrix() const;
+	Matrix4 GetWorldToLocalMatrix() const;
 
 
 	virtual void OnEditorInspect() final;
 
+	virtual void SaveSnapshot(SnapshotWriter& Out) final;
+	virtual void LoadSnapshot(SnapshotReader& In) final;
+	virtual void OnSnapshotRestored() final;
+
 private:
-	std::string Name;
+	StringTable::Id NameId = StringTable::kEmptyId;
 
 	Quaternion LocalRotation;
 	Vector3 LocalPosition;
 	Vector3 LocalScale;
 
-	Matrix4 LocalToWorldMatrix;
-	Matrix4 WorldToLocalMatrix;
+	// Mutable so GetMatrix can fill the cache of transforms outside a hierarchy, otherwise only written by SceneCore's pass
+	mutable Matrix4 LocalToWorldMatrix;
+
+	mutable bool IsLocalToWorldDirty = true;
+	bool IsPhysicsSyncPending = true;
+
+	// Set while this transform has a node in the scene hierarchy
+	SceneCore* Hierarchy = nullptr;
+	bool Static = false;
 
-	bool IsLocalToWorldDirty = true;
-	bool IsWorldToLocalDirty = true;
+	// Parent entity read by LoadSnapshot, relinked once every snapshot transform exists
+	EntityID SnapshotParent;
 
-	SharedPtr<Transform> ParentTransform;
-	std::vector<SharedPtr<Transform>> Children;
-	bool m_isDirty = true;
+	// Hierarchy owning this transform, looked up on the entity's world if it hasn't been placed yet
+	SceneCore* GetHierarchy();
 
 	void SetDirty(bool Dirty);
 	virtual void OnSerialize(json& outJson) final;
@@ -13,4 +13,14 @@ void EngineConfig::OnLoad(const json& inJson)
 
         WindowSize = { WindowWidth, WindowHeight };
     }
+
+    if (inJson.contains("Jobs"))
+    {
+        const json& JobsConfig = GetJsonObject("Jobs");
+
+        JobSettings.WorkerCount = JobsConfig.value("WorkerCount", JobSettings.WorkerCount);
+        JobSettings.JobsPerWorker = JobsConfig.value("JobsPerWorker", JobSettings.JobsPerWorker);
+        JobSettings.UseSMT = JobsConfig.value("UseSMT", JobSettings.UseSMT);
+        JobSettings.PinWorkers = JobsConfig.value("PinWorkers", JobSettings.PinWorkers);
+    }
 }
\ No newline at end of file
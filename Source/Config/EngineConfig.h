@@ -1,5 +1,6 @@
 #pragma once
 #include "Config.h"
+#include "Work/JobEngine.h"
 #include <stdio.h>
 
 class EngineConfig
@@ -20,4 +21,7 @@ public:
     virtual void OnLoad(const json& inJson) final;
 
     Vector2 WindowSize;
+
+    // Optional "Jobs" block, anything missing keeps the hardware based defaults
+    JobEngineSettings JobSettings;
 };
\ No newline at end of file
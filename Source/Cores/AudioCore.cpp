@@ -4,13 +4,14 @@
 #include "Events/AudioEvents.h"
 #include "optick.h"
 #include "Resource/ResourceCache.h"
+#include "Engine/World.h"
 
 #ifdef FMOD_ENABLED
 #include "fmod.hpp"
 #endif
 
 AudioCore::AudioCore()
-	: Base(ComponentFilter().Requires<AudioSource>())
+	: Base(ComponentFilter().Requires<AudioSource>().Writes<AudioSource>().RunsOnMainThread())
 {
 	SetIsSerializable(false);
 
@@ -45,6 +46,11 @@ AudioCore::AudioCore()
 	EventManager::GetInstance().RegisterReceiver(this, events);
 }
 
+void AudioCore::Update(const UpdateContext& inUpdateContext)
+{
+	Update(inUpdateContext.GetDeltaTime());
+}
+
 void AudioCore::Update(float dt)
 {
 	OPTICK_CATEGORY("AudioCore Update", Optick::Category::Audio);
@@ -55,13 +61,9 @@ void AudioCore::Update(float dt)
 		system->update();
 	}
 #endif
-	auto& AudioEntities = GetEntities();
-	for (auto& ent : AudioEntities)
-	{
-		AudioSource& audioSource = ent.GetComponent<AudioSource>();
-
+	GetWorld().Query<AudioSource>().MemberOf<AudioCore>().Each([this](AudioSource& audioSource) {
 		InitComponent(audioSource);
-	}
+	});
 }
 
 void AudioCore::InitComponent(AudioSource& audioSource)
@@ -18,6 +18,7 @@ class AudioCore
 public:
 	AudioCore();
 
+	virtual void Update(const UpdateContext& inUpdateContext) final;
 	virtual void Update(float dt) final;
 
 	void InitComponent(AudioSource& audioSource);
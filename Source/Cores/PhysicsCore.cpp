@@ -18,7 +18,8 @@
 #include "Physics/ICollisionEventReciever.h"
 
 PhysicsCore::PhysicsCore()
-	: Base(ComponentFilter().Requires<Transform>().RequiresOneOf<Rigidbody>().RequiresOneOf<CharacterController>())
+	: Base(ComponentFilter().Requires<Transform>().RequiresOneOf<Rigidbody>().RequiresOneOf<CharacterController>()
+		.Writes<Transform>().Writes<Rigidbody>().Writes<CharacterController>())
 {
 	Gravity = btVector3(0, -9.8f, 0);
 	///collision configuration contains default setup for memory, collision setup. Advanced users can create their own configuration.
@@ -62,8 +63,6 @@ void PhysicsCore::Update(const UpdateContext& inUpdateContext)
 	// Need a fixed delta probably
 	PhysicsWorld->stepSimulation(inUpdateContext.GetDeltaTime(), 10);
 
-	std::vector<std::pair<int, int>> batches;
-	Burst::GenerateChunks(PhysicsEntites.size(), 11, batches);
 	if (PhysicsEntites.size() <= 0)
 	{
 		return;
@@ -85,102 +84,92 @@ void PhysicsCore::Update(const UpdateContext& inUpdateContext)
 	//	}
 	//}
 
-	auto [worker, pool] = GetEngine().GetJobSystemNew();
+	JobEngine& jobEngine = GetEngine().GetJobEngine();
 
-	Job* rootJob = pool.CreateClosureJob([](Job& job) {
+	// Bodies are added to the bullet world here rather than in the jobs below, only new rigidbodies are visited
+	GetWorld().Query<Transform, Rigidbody>().MemberOf<PhysicsCore>().Added<Rigidbody>(GetLastUpdateTick()).Each([this](Transform& TransformComponent, Rigidbody& RigidbodyComponent) {
+		InitRigidbody(RigidbodyComponent, TransformComponent);
+	});
 
-		});
+	// Rigidbodies are only read, Transform is written for dynamic bodies that moved. Its setters stamp the change tick,
+	// so rows skipped here stay unchanged for RenderCore's Changed<Transform>
+	GetWorld().Query<Transform, const Rigidbody>().MemberOf<PhysicsCore>().ParallelEach(jobEngine, [](Transform& TransformComponent, const Rigidbody& RigidbodyComponent) {
+		OPTICK_CATEGORY("Job::UpdatePhysics", Optick::Category::Physics);
 
-	for (auto& batch : batches)
-	{
-		int batchBegin = batch.first;
-		int batchEnd = batch.second;
-		int batchSize = batchEnd - batchBegin;
-
-		//YIKES(std::to_string(batchBegin) + " End:" + std::to_string(batchEnd) + " Size:" + std::to_string(batchSize));
-		Job* root2 = pool.CreateClosureJobAsChild([this, &PhysicsEntites, batchBegin, batchEnd, batchSize, inUpdateContext](Job& job) {
-			OPTICK_CATEGORY("Job::UpdatePhysics", Optick::Category::Physics);
-
-			for (int entIndex = batchBegin; entIndex < batchEnd; ++entIndex)
-			{
-				Entity& InEntity = PhysicsEntites[entIndex];
-				Transform& TransformComponent = InEntity.GetComponent<Transform>();
-
-				if (InEntity.HasComponent<Rigidbody>())
-				{
-					Rigidbody& RigidbodyComponent = InEntity.GetComponent<Rigidbody>();
-
-					InitRigidbody(RigidbodyComponent, TransformComponent);
-
-					btRigidBody* rigidbody = RigidbodyComponent.InternalRigidbody;
-					btTransform& trans = rigidbody->getWorldTransform();
-
-
-					if (TransformComponent.IsDirty())
-					{
-						btTransform trans;
-						Vector3 transPos = TransformComponent.GetWorldPosition();
-						trans.setRotation(btQuaternion(TransformComponent.GetRotation().x, TransformComponent.GetRotation().y, TransformComponent.GetRotation().z, TransformComponent.GetRotation().w));
-						trans.setOrigin(btVector3(transPos.x, transPos.y, transPos.z));
-						rigidbody->setWorldTransform(trans);
-						rigidbody->activate();
-					}
-					else if (RigidbodyComponent.IsDynamic())
-					{
-						btTransform& trans = rigidbody->getWorldTransform();
-						btQuaternion rot;
-						trans.getBasis().getRotation(rot);
-						Vector3 bulletPosition = Vector3(trans.getOrigin().x(), trans.getOrigin().y(), trans.getOrigin().z());
-						TransformComponent.SetPosition(bulletPosition);
-						btScalar x, y, z;
-						rot.getEulerZYX(z, y, x);
-						TransformComponent.SetRotation(Vector3(Mathf::Degrees(x), Mathf::Degrees(y), Mathf::Degrees(z)));
-						//Transform tempTrans;
-						//tempTrans.SetPosition(bulletPosition);
-
-						//Matrix4 mat;
-						//Quaternion rot2(tempTrans.Rotation.GetInternalVec());
-						//mat.GetInternalMatrix().CreateWorld(tempTrans.GetPosition().GetInternalVec(), tempTrans.Rotation.GetInternalVec().Forward, tempTrans.Rotation.GetInternalVec().Up);
-						//tempTrans.SetWorldTransform(mat);
-						//DirectX::SimpleMath::Matrix id = DirectX::XMMatrixIdentity();
-						//DirectX::SimpleMath::Matrix rot = DirectX::SimpleMath::Matrix::CreateFromQuaternion(XMQuaternionRotationRollPitchYawFromVector(tempTrans.Rotation.GetInternalVec()));
-						//DirectX::SimpleMath::Matrix scale = DirectX::SimpleMath::Matrix::CreateScale(Child->GetScale().GetInternalVec());
-						//DirectX::SimpleMath::Matrix pos = XMMatrixTranslationFromVector(Child->GetPosition().GetInternalVec());
-						//Child->SetWorldTransform(Matrix4((rot * scale * pos) * CurrentTransform->WorldTransform.GetInternalMatrix()));
-						//GetEngine().GetRenderer().UpdateMatrix(RigidbodyComponent.DebugColliderId, TransformComponent.GetMatrix().GetInternalMatrix());
-					}
-				}
-
-				if (InEntity.HasComponent<CharacterController>())
-				{
-					CharacterController& Controller = InEntity.GetComponent<CharacterController>();
-
-					//
-					btRigidBody* rigidbody = Controller.m_rigidbody;
-					btTransform& trans = rigidbody->getWorldTransform();
-
-					Quaternion rotation = TransformComponent.GetWorldRotation();
-					trans.setRotation(btQuaternion(rotation[0], rotation[1], rotation[2], rotation[3]));
-					////trans.setOrigin(btVector3(transPos.X(), transPos.Y(), transPos.Z()));
-					////rigidbody->setWorldTransform(trans);
-					rigidbody->setWorldTransform(trans);
-					rigidbody->activate();
-
-					Controller.Update(inUpdateContext);
-
-					TransformComponent.SetWorldPosition(Controller.GetPosition());
-				}
-			}
-		}, rootJob);
-
-		worker->Submit(root2);
-		//GetEngine().GetJobEngine().AddWork(m_callBack);
-		//GetEngine().GetJobEngine().Wait();
-		//burst.AddWork2(job, sizeof(Burst::LambdaWorkEntry));
-	}
-	worker->Submit(rootJob);
-	worker->Wait(rootJob);
-	//burst.FinalizeWork();
+		// Not in the bullet world yet
+		if (!RigidbodyComponent.InternalRigidbody)
+		{
+			return;
+		}
+
+		// Level geometry, the body was placed once and never needs syncing
+		if (TransformComponent.IsFrozen())
+		{
+			return;
+		}
+
+		btRigidBody* rigidbody = RigidbodyComponent.InternalRigidbody;
+		btTransform& trans = rigidbody->getWorldTransform();
+
+
+		// Moved by gameplay or a parent since the last sync, teleport the body there
+		if (TransformComponent.NeedsPhysicsSync())
+		{
+			btTransform trans;
+			Vector3 transPos = TransformComponent.GetWorldPosition();
+			trans.setRotation(btQuaternion(TransformComponent.GetRotation().x, TransformComponent.GetRotation().y, TransformComponent.GetRotation().z, TransformComponent.GetRotation().w));
+			trans.setOrigin(btVector3(transPos.x, transPos.y, transPos.z));
+			rigidbody->setWorldTransform(trans);
+			rigidbody->activate();
+			TransformComponent.ClearPhysicsSync();
+		}
+		// Sleeping bodies haven't moved, writing their pose back would only mark them changed
+		else if (RigidbodyComponent.IsDynamic() && rigidbody->isActive())
+		{
+			btTransform& trans = rigidbody->getWorldTransform();
+			btQuaternion rot;
+			trans.getBasis().getRotation(rot);
+			Vector3 bulletPosition = Vector3(trans.getOrigin().x(), trans.getOrigin().y(), trans.getOrigin().z());
+			TransformComponent.SetPosition(bulletPosition);
+			btScalar x, y, z;
+			rot.getEulerZYX(z, y, x);
+			TransformComponent.SetRotation(Vector3(Mathf::Degrees(x), Mathf::Degrees(y), Mathf::Degrees(z)));
+			// Our own write, the body is already there
+			TransformComponent.ClearPhysicsSync();
+			//Transform tempTrans;
+			//tempTrans.SetPosition(bulletPosition);
+
+			//Matrix4 mat;
+			//Quaternion rot2(tempTrans.Rotation.GetInternalVec());
+			//mat.GetInternalMatrix().CreateWorld(tempTrans.GetPosition().GetInternalVec(), tempTrans.Rotation.GetInternalVec().Forward, tempTrans.Rotation.GetInternalVec().Up);
+			//tempTrans.SetWorldTransform(mat);
+			//DirectX::SimpleMath::Matrix id = DirectX::XMMatrixIdentity();
+			//DirectX::SimpleMath::Matrix rot = DirectX::SimpleMath::Matrix::CreateFromQuaternion(XMQuaternionRotationRollPitchYawFromVector(tempTrans.Rotation.GetInternalVec()));
+			//DirectX::SimpleMath::Matrix scale = DirectX::SimpleMath::Matrix::CreateScale(Child->GetScale().GetInternalVec());
+			//DirectX::SimpleMath::Matrix pos = XMMatrixTranslationFromVector(Child->GetPosition().GetInternalVec());
+			//Child->SetWorldTransform(Matrix4((rot * scale * pos) * CurrentTransform->WorldTransform.GetInternalMatrix()));
+			//GetEngine().GetRenderer().UpdateMatrix(RigidbodyComponent.DebugColliderId, TransformComponent.GetMatrix().GetInternalMatrix());
+		}
+	});
+
+	GetWorld().Query<Transform, CharacterController>().MemberOf<PhysicsCore>().ParallelEach(jobEngine, [&inUpdateContext](Transform& TransformComponent, CharacterController& Controller) {
+		OPTICK_CATEGORY("Job::UpdatePhysics", Optick::Category::Physics);
+
+		//
+		btRigidBody* rigidbody = Controller.m_rigidbody;
+		btTransform& trans = rigidbody->getWorldTransform();
+
+		Quaternion rotation = TransformComponent.GetWorldRotation();
+		trans.setRotation(btQuaternion(rotation[0], rotation[1], rotation[2], rotation[3]));
+		////trans.setOrigin(btVector3(transPos.X(), transPos.Y(), transPos.Z()));
+		////rigidbody->setWorldTransform(trans);
+		rigidbody->setWorldTransform(trans);
+		rigidbody->activate();
+
+		Controller.Update(inUpdateContext);
+
+		TransformComponent.SetWorldPosition(Controller.GetPosition());
+	});
 }
 
 void PhysicsCore::OnEntityAdded(Entity& NewEntity)
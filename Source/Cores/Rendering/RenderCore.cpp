@@ -24,7 +24,7 @@
 #include <Core/JobSystem.h>
 
 RenderCore::RenderCore()
-	: Base(ComponentFilter().Requires<Transform>().Requires<Mesh>())
+	: Base(ComponentFilter().Requires<Transform>().Requires<Mesh>().Reads<Transform>().Reads<Mesh>())
 {
 	SetIsSerializable(false);
 	//m_renderer = &GetEngine().GetRenderer();
@@ -78,66 +78,17 @@ void RenderCore::Update(const UpdateContext& inUpdateContext)
 	OPTICK_CATEGORY("RenderCore::Update", Optick::Category::Rendering)
 	//m_renderer->Update(dt);
 
-	auto& Renderables = GetEntities();
-	if (Renderables.empty())
+	if (GetEntities().empty())
 	{
 		return;
 	}
-    
-    //auto [worker, pool] = GetEngine().GetJobSystemNew();
 
-    Worker* worker = GetEngine().GetJobEngine().GetThreadWorker();
-    Job* rootJob = worker->GetPool().CreateClosureJob([&Renderables, worker](Job& job) {
-    
-    });
-
-	std::vector<std::pair<int, int>> batches;
-	Burst::GenerateChunks(Renderables.size(), 11, batches);
-
-	worker->Submit(rootJob);
-	for (auto& batch : batches)
-	{
-		int batchBegin = batch.first;
-		int batchEnd = batch.second;
-		int batchSize = batchEnd - batchBegin;
-
-		//YIKES(std::to_string(batchBegin) + " End:" + std::to_string(batchEnd) + " Size:" + std::to_string(batchSize));
-		Job* burstJob = worker->GetPool().CreateClosureJobAsChild([&Renderables, batchBegin, batchEnd, batchSize](Job& job) {
-			if (Renderables.size() == 0)
-			{
-				return;
-			}
-			for (int entIndex = batchBegin; entIndex < batchEnd; ++entIndex)
-			{
-				auto& InEntity = Renderables[entIndex];
-				OPTICK_CATEGORY("B::Update Mesh Matrix", Optick::Category::Debug);
-
-				if (InEntity/* && !InEntity.IsLoading*/)
-				{
-
-					Transform& transform = InEntity.GetComponent<Transform>();
-					if (InEntity.HasComponent<Mesh>())
-					{
-						Mesh& model = InEntity.GetComponent<Mesh>();
-
-						GetEngine().GetRenderer().UpdateMeshMatrix(model.GetId(), transform.GetMatrix().GetInternalMatrix());
-					}
-					if (InEntity.HasComponent<DirectionalLight>())
-					{
-						//DirectionalLight& light = InEntity.GetComponent<DirectionalLight>();
-						//auto pos = transform.GetWorldPosition();
-						//m_renderer->Sunlight.pos = XMFLOAT4(pos.x, pos.y, pos.z, 0);
-						//m_renderer->Sunlight.ambient = light.Ambient;
-						//m_renderer->Sunlight.diffuse = light.Diffuse;
-						//m_renderer->Sunlight.dir = light.Direction;
-					}
-				}
-
-			}
-		}, rootJob);
-		worker->Submit(burstJob);
-	}
-    worker->Wait(rootJob);
+	// Only meshes that moved or were rebuilt since the last frame need a new matrix
+	const std::uint32_t lastUpdate = GetLastUpdateTick();
+	GetWorld().Query<const Transform, const Mesh>().MemberOf<RenderCore>().Changed<Transform>(lastUpdate).Changed<Mesh>(lastUpdate).ParallelEach(GetEngine().GetJobEngine(), [](const Transform& transform, const Mesh& model) {
+		OPTICK_CATEGORY("B::Update Mesh Matrix", Optick::Category::Debug);
+		GetEngine().GetRenderer().UpdateMeshMatrix(model.GetId(), transform.GetMatrix().GetInternalMatrix());
+	});
 	//for (auto& InEntity : Renderables)
 	//{
 	//	//OPTICK_CATEGORY("Update Mesh", Optick::Category::Rendering);
@@ -205,6 +156,9 @@ void RenderCore::UpdateMesh(Mesh* InMesh)
 	command.MeshMaterial = InMesh->MeshMaterial;
 	command.Type = InMesh->GetType();
 	InMesh->Id = GetEngine().GetRenderer().GetMeshCache().Push(command);
+
+	// The new mesh command has no transform yet, let Update send it
+	InMesh->MarkChanged();
 }
 
 #if ME_EDITOR
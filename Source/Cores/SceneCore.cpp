@@ -2,15 +2,26 @@
 #include "Cores/SceneCore.h"
 #include "Components/Transform.h"
 #include "Engine/World.h"
+#include "Work/Burst.h"
+#include "Work/JobEngine.h"
+#include "optick.h"
+#include <algorithm>
 
 SceneCore::SceneCore()
-	: Base(ComponentFilter().Requires<Transform>())
+	: Base(ComponentFilter().Requires<Transform>().Writes<Transform>())
 {
 	SetIsSerializable(false);
 }
 
 SceneCore::~SceneCore()
 {
+	for (Transform* InTransform : Transforms)
+	{
+		if (InTransform)
+		{
+			InTransform->Hierarchy = nullptr;
+		}
+	}
 }
 
 void SceneCore::Init()
@@ -22,13 +33,33 @@ void SceneCore::Init()
 	}
 }
 
+void SceneCore::Update(const UpdateContext& InUpdateContext)
+{
+	UpdateWorldMatrices();
+}
+
+void SceneCore::OnStart()
+{
+	// Static transforms are editable until the game starts, settle anything still pending before fixing their world matrix
+	UpdateWorldMatrices();
+	IsFreezingEnabled = true;
+	RefreshFrozenRoots();
+}
+
+void SceneCore::OnStop()
+{
+	IsFreezingEnabled = false;
+	PendingFrozenNodes.clear();
+	RefreshFrozenRoots();
+}
+
 void SceneCore::OnEntityAdded(Entity& NewEntity)
 {
 	Base::OnEntityAdded(NewEntity);
 
 	Transform& NewEntityTransform = NewEntity.GetComponent<Transform>();
 
-	if (!NewEntityTransform.ParentTransform && !(NewEntity.GetId() == RootTransformEntity->GetId()))
+	if (!GetParent(NewEntityTransform) && !(NewEntity.GetId() == RootTransformEntity->GetId()))
 	{
 		NewEntityTransform.SetParent(*GetRootTransform());
 	}
@@ -41,15 +72,734 @@ Transform* SceneCore::GetRootTransform()
 
 void SceneCore::OnEntityRemoved(Entity& InEntity)
 {
-	
+	// Deactivated entities keep their place, only drop the node once the Transform itself is gone
+	if (!InEntity.HasComponent<Transform>() && InEntity.GetId().Index < Transforms.size())
+	{
+		if (Transform* Removed = Transforms[InEntity.GetId().Index])
+		{
+			RemoveNode(*Removed);
+		}
+	}
 }
 
 void SceneCore::OnEntityDestroyed(Entity& InEntity)
 {
-	Transform& transform = InEntity.GetComponent<Transform>();
-	if (transform.ParentTransform.get())
+	RemoveNode(InEntity.GetComponent<Transform>());
+}
+
+void SceneCore::SetParent(Transform& InChild, Transform* InParent)
+{
+	const std::uint32_t Child = GetOrAddNode(InChild);
+	const std::uint32_t Parent = InParent ? GetOrAddNode(*InParent) : kInvalidNode;
+	if (Parents[Child] == Parent || Child == Parent)
+	{
+		return;
+	}
+
+	// Refuse to create a cycle
+	for (std::uint32_t Ancestor = Parent; Ancestor != kInvalidNode; Ancestor = Parents[Ancestor])
+	{
+		if (Ancestor == Child)
+		{
+			return;
+		}
+	}
+
+	Unlink(Child);
+
+	if (Parent != kInvalidNode)
+	{
+		Parents[Child] = Parent;
+		PrevSiblings[Child] = LastChildren[Parent];
+		if (LastChildren[Parent] != kInvalidNode)
+		{
+			NextSiblings[LastChildren[Parent]] = Child;
+		}
+		else
+		{
+			FirstChildren[Parent] = Child;
+		}
+		LastChildren[Parent] = Child;
+		AddToChildNameIndex(Child);
+	}
+
+	UpdateSubtreeDepth(Child);
+	RefreshFrozen(Child);
+	MarkDirty(Child);
+	MarkHierarchyChanged();
+}
+
+Transform* SceneCore::GetParent(const Transform& InChild) const
+{
+	const std::uint32_t Child = GetNode(InChild);
+	return (Child != kInvalidNode && Parents[Child] != kInvalidNode) ? Transforms[Parents[Child]] : nullptr;
+}
+
+std::size_t SceneCore::GetChildCount(const Transform& InParent) const
+{
+	std::size_t Count = 0;
+	ForEachChild(InParent, [&Count](Transform&) {
+		++Count;
+	});
+	return Count;
+}
+
+bool SceneCore::HasChildren(const Transform& InParent) const
+{
+	const std::uint32_t Node = GetNode(InParent);
+	return Node != kInvalidNode && FirstChildren[Node] != kInvalidNode;
+}
+
+std::uint32_t SceneCore::GetDepth(const Transform& InTransform) const
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	return Node != kInvalidNode ? Depths[Node] : 0;
+}
+
+const std::vector<std::uint32_t>& SceneCore::GetDepthSortedNodes()
+{
+	if (!IsDepthOrderDirty)
+	{
+		return DepthSortedNodes;
+	}
+
+	// Breadth first from every parentless node, every root has depth 0 so the queue comes out sorted by depth
+	DepthSortedNodes.clear();
+	for (std::uint32_t Node = 0; Node < Transforms.size(); ++Node)
+	{
+		if (Transforms[Node] && Parents[Node] == kInvalidNode)
+		{
+			DepthSortedNodes.push_back(Node);
+		}
+	}
+
+	for (std::size_t i = 0; i < DepthSortedNodes.size(); ++i)
+	{
+		for (std::uint32_t Child = FirstChildren[DepthSortedNodes[i]]; Child != kInvalidNode; Child = NextSiblings[Child])
+		{
+			DepthSortedNodes.push_back(Child);
+		}
+	}
+
+	IsDepthOrderDirty = false;
+	return DepthSortedNodes;
+}
+
+Transform* SceneCore::GetTransform(std::uint32_t InNode) const
+{
+	return InNode < Transforms.size() ? Transforms[InNode] : nullptr;
+}
+
+Transform* SceneCore::FindChild(const Transform& InParent, StringTable::Id InNameId) const
+{
+	const std::uint32_t Parent = GetNode(InParent);
+	if (Parent == kInvalidNode)
+	{
+		return nullptr;
+	}
+
+	auto it = ChildNameIndex.find(GetChildNameKey(Parent, InNameId));
+	return (it != ChildNameIndex.end()) ? Transforms[it->second] : nullptr;
+}
+
+Transform* SceneCore::FindTransform(StringTable::Id InNameId) const
+{
+	auto it = NameIndex.find(InNameId);
+	return (it != NameIndex.end() && !it->second.empty()) ? Transforms[it->second.front()] : nullptr;
+}
+
+Transform* SceneCore::FindTransform(const std::string& InName) const
+{
+	const StringTable::Id Id = StringTable::Get().Find(InName);
+	return (Id != StringTable::kNotFound) ? FindTransform(Id) : nullptr;
+}
+
+std::uint64_t SceneCore::GetChildNameKey(std::uint32_t InParent, StringTable::Id InNameId)
+{
+	return (static_cast<std::uint64_t>(InParent) << 32) | InNameId;
+}
+
+void SceneCore::AddToNameIndex(std::uint32_t InNode)
+{
+	NameIndex[Transforms[InNode]->NameId].push_back(InNode);
+}
+
+void SceneCore::RemoveFromNameIndex(std::uint32_t InNode, StringTable::Id InNameId)
+{
+	auto it = NameIndex.find(InNameId);
+	if (it == NameIndex.end())
+	{
+		return;
+	}
+
+	std::vector<std::uint32_t>& Nodes = it->second;
+	Nodes.erase(std::remove(Nodes.begin(), Nodes.end(), InNode), Nodes.end());
+	if (Nodes.empty())
+	{
+		NameIndex.erase(it);
+	}
+}
+
+void SceneCore::AddToChildNameIndex(std::uint32_t InNode)
+{
+	// Keeps an existing entry, the earlier sibling stays the one found
+	ChildNameIndex.emplace(GetChildNameKey(Parents[InNode], Transforms[InNode]->NameId), InNode);
+}
+
+void SceneCore::RemoveFromChildNameIndex(std::uint32_t InNode, std::uint32_t InParent, StringTable::Id InNameId)
+{
+	const std::uint64_t Key = GetChildNameKey(InParent, InNameId);
+	auto it = ChildNameIndex.find(Key);
+	if (it == ChildNameIndex.end() || it->second != InNode)
+	{
+		return;
+	}
+
+	ChildNameIndex.erase(it);
+	for (std::uint32_t Child = FirstChildren[InParent]; Child != kInvalidNode; Child = NextSiblings[Child])
+	{
+		if (Child != InNode && Transforms[Child]->NameId == InNameId)
+		{
+			ChildNameIndex.emplace(Key, Child);
+			break;
+		}
+	}
+}
+
+void SceneCore::OnNameChanged(Transform& InTransform, StringTable::Id InOldNameId)
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	if (Node == kInvalidNode)
+	{
+		return;
+	}
+
+	RemoveFromNameIndex(Node, InOldNameId);
+	AddToNameIndex(Node);
+	if (Parents[Node] != kInvalidNode)
+	{
+		RemoveFromChildNameIndex(Node, Parents[Node], InOldNameId);
+		AddToChildNameIndex(Node);
+	}
+}
+
+void SceneCore::UpdateWorldMatrices()
+{
+	OPTICK_EVENT("SceneCore::UpdateWorldMatrices");
+	if (IsBatchLayoutDirty)
+	{
+		RebuildBatchLayout();
+	}
+
+	// Every dirty root covers its whole subtree, which is one contiguous run of slots.
+	// Roots below another dirty root are already covered and are skipped.
+	DirtyRanges.clear();
+	DirtyRootSlots.clear();
+	const std::uint32_t RootCount = DirtyRootCount.load(std::memory_order_relaxed);
+	for (std::uint32_t i = 0; i < RootCount; ++i)
+	{
+		const std::uint32_t Node = DirtyRoots[i];
+
+		// Gone when the node was removed after being marked, frozen nodes pick up their changes once unfrozen
+		if (!Transforms[Node] || FrozenNodes[Node])
+		{
+			continue;
+		}
+
+		const std::uint32_t Slot = NodeSlots[Node];
+		if (Parents[Node] == kInvalidNode)
+		{
+			// The root slot itself is done up front, each child subtree below it is an independent range
+			DirtyRootSlots.push_back(Slot);
+			const auto& Descendants = RootSubtreeRanges[Slot];
+			for (std::uint32_t Child = Descendants.first; Child < Descendants.second; Child = SlotSubtreeEnds[Child])
+			{
+				DirtyRanges.push_back({ Child, SlotSubtreeEnds[Child] });
+			}
+		}
+		else if (!HasDirtyAncestor(Node))
+		{
+			DirtyRanges.push_back({ Slot, SlotSubtreeEnds[Slot] });
+		}
+	}
+
+	// Children read their parent's world matrix, so the parentless slots have to be final before the ranges start
+	for (const std::uint32_t Slot : DirtyRootSlots)
+	{
+		UpdateSlotRange(Slot, Slot + 1);
+		MarkChangedSlots(Slot, Slot + 1);
+	}
+
+	// Keep slot order so neighbouring ranges end up in the same job, no two jobs may sweep the same slots
+	std::sort(DirtyRanges.begin(), DirtyRanges.end());
+	DirtyRanges.erase(std::unique(DirtyRanges.begin(), DirtyRanges.end()), DirtyRanges.end());
+	UpdateSlotRanges(DirtyRanges);
+	for (const auto& Range : DirtyRanges)
+	{
+		MarkChangedSlots(Range.first, Range.second);
+	}
+
+	// Cleared after the sweep, it tells nodes that moved themselves apart from the ones a parent moved
+	for (std::uint32_t i = 0; i < RootCount; ++i)
+	{
+		DirtyNodes[DirtyRoots[i]].Value.store(0, std::memory_order_relaxed);
+	}
+	DirtyRootCount.store(0, std::memory_order_relaxed);
+
+	RefreshPendingFrozen();
+}
+
+void SceneCore::UpdateSlotRanges(const std::vector<std::pair<std::uint32_t, std::uint32_t>>& InRanges)
+{
+	JobEngine* Jobs = GameWorld ? GameWorld->GetJobEngine() : nullptr;
+	if (!Jobs || InRanges.size() < 2)
+	{
+		for (const auto& Range : InRanges)
+		{
+			UpdateSlotRange(Range.first, Range.second);
+		}
+		return;
+	}
+
+	// Ranges differ in size, pick the grain from the average so a job still gets about kMinNodesPerJob nodes
+	std::size_t NodeCount = 0;
+	for (const auto& Range : InRanges)
+	{
+		NodeCount += Range.second - Range.first;
+	}
+	const std::size_t GrainSize = std::max<std::size_t>(kMinNodesPerJob * InRanges.size() / std::max<std::size_t>(NodeCount, 1), 1);
+
+	// Ranges don't overlap and only read slots that are already final,
+	// the result doesn't depend on which worker picks up which range
+	Burst::ParallelFor(*Jobs, 0, InRanges.size(), GrainSize, [this, &InRanges](std::size_t First, std::size_t Last) {
+		OPTICK_EVENT("SceneCore::UpdateSlotRange");
+		for (std::size_t Range = First; Range < Last; ++Range)
+		{
+			UpdateSlotRange(InRanges[Range].first, InRanges[Range].second);
+		}
+	});
+}
+
+void SceneCore::UpdateSlotRange(std::uint32_t InBegin, std::uint32_t InEnd)
+{
+	// Frozen nodes keep the matrix they had when they were frozen, their whole subtree is jumped over
+	for (std::uint32_t Slot = InBegin; Slot < InEnd; ++Slot)
+	{
+		const std::uint32_t Node = SlotNodes[Slot];
+		if (FrozenNodes[Node])
+		{
+			Slot = SlotSubtreeEnds[Slot] - 1;
+			continue;
+		}
+
+		const Transform& Local = *Transforms[Node];
+		SlotPositions[Slot] = Local.LocalPosition.InternalVector;
+		SlotRotations[Slot] = Local.LocalRotation.InternalQuat;
+		SlotScales[Slot] = Local.LocalScale.InternalVector;
+	}
+
+	// Parents sit in earlier slots, so their world matrix is final by the time a child reads it
+	for (std::uint32_t Slot = InBegin; Slot < InEnd; ++Slot)
+	{
+		if (FrozenNodes[SlotNodes[Slot]])
+		{
+			Slot = SlotSubtreeEnds[Slot] - 1;
+			continue;
+		}
+
+		const AffineMatrix LocalMatrix = AffineMatrix::FromTRS(SlotPositions[Slot], SlotRotations[Slot], SlotScales[Slot]);
+		const std::uint32_t ParentSlot = SlotParents[Slot];
+		if (ParentSlot != kInvalidNode)
+		{
+			AffineMatrix::Multiply(SlotWorldMatrices[ParentSlot], LocalMatrix, SlotWorldMatrices[Slot]);
+		}
+		else
+		{
+			SlotWorldMatrices[Slot] = LocalMatrix;
+		}
+	}
+
+	// Children moved by a parent never had their own setters called, flag the ones that actually changed for MarkChangedSlots
+	for (std::uint32_t Slot = InBegin; Slot < InEnd; ++Slot)
+	{
+		Transform& Result = *Transforms[SlotNodes[Slot]];
+		if (FrozenNodes[SlotNodes[Slot]])
+		{
+			Slot = SlotSubtreeEnds[Slot] - 1;
+			continue;
+		}
+
+		ComputedNodes[SlotNodes[Slot]] = 1;
+
+		// Render and physics consume glm matrices, the conversion happens once here
+		const glm::mat4 WorldMatrix = SlotWorldMatrices[Slot].ToGlm();
+		if (Result.LocalToWorldMatrix.GetInternalMatrix() != WorldMatrix)
+		{
+			Result.LocalToWorldMatrix = Matrix4(WorldMatrix);
+			SlotChanged[Slot] = 1;
+
+			// Moved by a parent, a node that moved itself already asked for the sync and may have been moved by physics
+			if (!DirtyNodes[SlotNodes[Slot]].IsSet())
+			{
+				Result.IsPhysicsSyncPending = true;
+			}
+		}
+		Result.IsLocalToWorldDirty = false;
+	}
+}
+
+void SceneCore::MarkChangedSlots(std::uint32_t InBegin, std::uint32_t InEnd)
+{
+	// Change ticks are kept per archetype chunk and slot ranges don't follow chunks, so this can't happen inside the jobs
+	for (std::uint32_t Slot = InBegin; Slot < InEnd; ++Slot)
+	{
+		if (SlotChanged[Slot])
+		{
+			SlotChanged[Slot] = 0;
+			Transforms[SlotNodes[Slot]]->MarkChanged();
+		}
+	}
+}
+
+bool SceneCore::HasDirtyAncestor(std::uint32_t InNode) const
+{
+	for (std::uint32_t Ancestor = Parents[InNode]; Ancestor != kInvalidNode; Ancestor = Parents[Ancestor])
+	{
+		if (DirtyNodes[Ancestor].IsSet())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool SceneCore::IsDirtyInHierarchy(const Transform& InTransform) const
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	return Node != kInvalidNode && !FrozenNodes[Node] && (DirtyNodes[Node].IsSet() || HasDirtyAncestor(Node));
+}
+
+bool SceneCore::IsFrozen(const Transform& InTransform) const
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	return Node != kInvalidNode && FrozenNodes[Node];
+}
+
+void SceneCore::RefreshFrozen(std::uint32_t InNode)
+{
+	// Frozen is inherited, a static node freezes everything below it
+	ForEachInSubtree(*Transforms[InNode], [this](Transform& InTransform) {
+		const std::uint32_t Node = GetNode(InTransform);
+		const std::uint32_t Parent = Parents[Node];
+		bool IsFrozen = IsFreezingEnabled && (InTransform.Static || (Parent != kInvalidNode && FrozenNodes[Parent]));
+		if (IsFrozen && !ComputedNodes[Node])
+		{
+			// Nothing to keep yet, freeze it once the pass has given it a world matrix
+			PendingFrozenNodes.push_back(Node);
+			IsFrozen = false;
+		}
+		if (FrozenNodes[Node] && !IsFrozen)
+		{
+			// Edits made while frozen show up now
+			MarkDirty(Node);
+		}
+		FrozenNodes[Node] = IsFrozen;
+	});
+}
+
+void SceneCore::RefreshFrozenRoots()
+{
+	for (std::uint32_t Node = 0; Node < Transforms.size(); ++Node)
+	{
+		if (Transforms[Node] && Parents[Node] == kInvalidNode)
+		{
+			RefreshFrozen(Node);
+		}
+	}
+}
+
+void SceneCore::RefreshPendingFrozen()
+{
+	if (PendingFrozenNodes.empty())
+	{
+		return;
+	}
+
+	// RefreshFrozen lists nodes again if they still haven't been computed, so work on a copy
+	std::vector<std::uint32_t> Pending;
+	Pending.swap(PendingFrozenNodes);
+	std::sort(Pending.begin(), Pending.end());
+	Pending.erase(std::unique(Pending.begin(), Pending.end()), Pending.end());
+	for (const std::uint32_t Node : Pending)
+	{
+		if (Transforms[Node])
+		{
+			RefreshFrozen(Node);
+		}
+	}
+}
+
+AffineMatrix SceneCore::ComputeWorldMatrix(const Transform& InTransform) const
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	if (Node == kInvalidNode)
+	{
+		return AffineMatrix();
+	}
+
+	// Everything above the highest dirty node still has a valid cached matrix
+	std::uint32_t TopDirty = Node;
+	for (std::uint32_t Ancestor = Parents[Node]; Ancestor != kInvalidNode; Ancestor = Parents[Ancestor])
+	{
+		if (DirtyNodes[Ancestor].IsSet())
+		{
+			TopDirty = Ancestor;
+		}
+	}
+
+	// Accumulate from the node upwards so no chain has to be stored
+	AffineMatrix World = AffineMatrix::FromTRS(InTransform.LocalPosition.InternalVector, InTransform.LocalRotation.InternalQuat, InTransform.LocalScale.InternalVector);
+	std::uint32_t Current = Node;
+	while (Current != TopDirty)
+	{
+		Current = Parents[Current];
+		const Transform& Ancestor = *Transforms[Current];
+		AffineMatrix::Multiply(AffineMatrix::FromTRS(Ancestor.LocalPosition.InternalVector, Ancestor.LocalRotation.InternalQuat, Ancestor.LocalScale.InternalVector), World, World);
+	}
+
+	if (Parents[TopDirty] != kInvalidNode)
+	{
+		AffineMatrix::Multiply(AffineMatrix(Transforms[Parents[TopDirty]]->LocalToWorldMatrix), World, World);
+	}
+	return World;
+}
+
+void SceneCore::RebuildBatchLayout()
+{
+	SlotNodes.clear();
+	for (std::uint32_t Node = 0; Node < Transforms.size(); ++Node)
+	{
+		if (Transforms[Node] && Parents[Node] == kInvalidNode)
+		{
+			SlotNodes.push_back(Node);
+		}
+	}
+	RootSlotCount = static_cast<std::uint32_t>(SlotNodes.size());
+
+	// Each child of a root brings its whole subtree, so everything below a root is one run of slots
+	RootSubtreeRanges.resize(RootSlotCount);
+	for (std::uint32_t RootSlot = 0; RootSlot < RootSlotCount; ++RootSlot)
+	{
+		RootSubtreeRanges[RootSlot].first = static_cast<std::uint32_t>(SlotNodes.size());
+		for (std::uint32_t Child = FirstChildren[SlotNodes[RootSlot]]; Child != kInvalidNode; Child = NextSiblings[Child])
+		{
+			ForEachInSubtree(*Transforms[Child], [this](Transform& InTransform) {
+				SlotNodes.push_back(GetNode(InTransform));
+			});
+		}
+		RootSubtreeRanges[RootSlot].second = static_cast<std::uint32_t>(SlotNodes.size());
+	}
+
+	const std::size_t SlotCount = SlotNodes.size();
+	NodeSlots.assign(Transforms.size(), kInvalidNode);
+	for (std::size_t Slot = 0; Slot < SlotCount; ++Slot)
+	{
+		NodeSlots[SlotNodes[Slot]] = static_cast<std::uint32_t>(Slot);
+	}
+
+	SlotParents.resize(SlotCount);
+	for (std::size_t Slot = 0; Slot < SlotCount; ++Slot)
+	{
+		const std::uint32_t Parent = Parents[SlotNodes[Slot]];
+		SlotParents[Slot] = (Parent != kInvalidNode) ? NodeSlots[Parent] : kInvalidNode;
+	}
+
+	// Subtrees below the root slots are depth first, so each one ends where its last descendant does
+	SlotSubtreeEnds.resize(SlotCount);
+	for (std::size_t Slot = 0; Slot < SlotCount; ++Slot)
+	{
+		SlotSubtreeEnds[Slot] = static_cast<std::uint32_t>(Slot + 1);
+	}
+	for (std::size_t Slot = SlotCount; Slot-- > RootSlotCount;)
+	{
+		const std::uint32_t ParentSlot = SlotParents[Slot];
+		if (ParentSlot >= RootSlotCount)
+		{
+			SlotSubtreeEnds[ParentSlot] = std::max(SlotSubtreeEnds[ParentSlot], SlotSubtreeEnds[Slot]);
+		}
+	}
+
+	SlotPositions.resize(SlotCount);
+	SlotRotations.resize(SlotCount);
+	SlotScales.resize(SlotCount);
+
+	// Clean nodes keep the matrix they were last given, only dirty ones are recomputed after a layout change
+	SlotWorldMatrices.resize(SlotCount);
+	SlotChanged.assign(SlotCount, 0);
+	for (std::size_t Slot = 0; Slot < SlotCount; ++Slot)
+	{
+		SlotWorldMatrices[Slot] = AffineMatrix(Transforms[SlotNodes[Slot]]->LocalToWorldMatrix);
+	}
+	IsBatchLayoutDirty = false;
+}
+
+void SceneCore::MarkDirty(const Transform& InTransform)
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	if (Node != kInvalidNode)
+	{
+		MarkDirty(Node);
+	}
+}
+
+void SceneCore::MarkDirty(std::uint32_t InNode)
+{
+	// Whoever sets the flag first lists the node
+	if (DirtyNodes[InNode].Value.exchange(1, std::memory_order_relaxed) == 0)
+	{
+		DirtyRoots[DirtyRootCount.fetch_add(1, std::memory_order_relaxed)] = InNode;
+	}
+}
+
+void SceneCore::MarkHierarchyChanged()
+{
+	IsDepthOrderDirty = true;
+	IsBatchLayoutDirty = true;
+}
+
+std::uint32_t SceneCore::GetOrAddNode(Transform& InTransform)
+{
+	const std::uint32_t Node = static_cast<std::uint32_t>(InTransform.Parent.GetId().Index);
+	if (Node >= Transforms.size())
+	{
+		const std::size_t NewSize = std::max<std::size_t>(Node + 1, Transforms.size() * 2);
+		Transforms.resize(NewSize, nullptr);
+		Parents.resize(NewSize, kInvalidNode);
+		FirstChildren.resize(NewSize, kInvalidNode);
+		LastChildren.resize(NewSize, kInvalidNode);
+		NextSiblings.resize(NewSize, kInvalidNode);
+		PrevSiblings.resize(NewSize, kInvalidNode);
+		Depths.resize(NewSize, 0);
+		DirtyNodes.resize(NewSize);
+		DirtyRoots.resize(NewSize);
+		FrozenNodes.resize(NewSize, 0);
+		ComputedNodes.resize(NewSize, 0);
+	}
+
+	if (Transforms[Node] != &InTransform)
+	{
+		// A stale node left behind by a previous owner of this entity index
+		if (Transforms[Node])
+		{
+			RemoveNode(*Transforms[Node]);
+		}
+		Transforms[Node] = &InTransform;
+		InTransform.Hierarchy = this;
+		// Frozen after the pass has computed it, until then the world matrix is still identity
+		FrozenNodes[Node] = 0;
+		ComputedNodes[Node] = 0;
+		if (IsFreezingEnabled && InTransform.Static)
+		{
+			PendingFrozenNodes.push_back(Node);
+		}
+		AddToNameIndex(Node);
+		MarkDirty(Node);
+		MarkHierarchyChanged();
+	}
+	return Node;
+}
+
+std::uint32_t SceneCore::GetNode(const Transform& InTransform) const
+{
+	const std::size_t Node = InTransform.Parent.GetId().Index;
+	return (Node < Transforms.size() && Transforms[Node] == &InTransform) ? static_cast<std::uint32_t>(Node) : kInvalidNode;
+}
+
+void SceneCore::Unlink(std::uint32_t InNode)
+{
+	const std::uint32_t Parent = Parents[InNode];
+	if (Parent == kInvalidNode)
+	{
+		return;
+	}
+
+	const std::uint32_t Prev = PrevSiblings[InNode];
+	const std::uint32_t Next = NextSiblings[InNode];
+	if (Prev != kInvalidNode)
+	{
+		NextSiblings[Prev] = Next;
+	}
+	else
+	{
+		FirstChildren[Parent] = Next;
+	}
+
+	if (Next != kInvalidNode)
+	{
+		PrevSiblings[Next] = Prev;
+	}
+	else
+	{
+		LastChildren[Parent] = Prev;
+	}
+
+	Parents[InNode] = kInvalidNode;
+	PrevSiblings[InNode] = kInvalidNode;
+	NextSiblings[InNode] = kInvalidNode;
+	RemoveFromChildNameIndex(InNode, Parent, Transforms[InNode]->NameId);
+}
+
+void SceneCore::UpdateSubtreeDepth(std::uint32_t InNode)
+{
+	const std::uint32_t Parent = Parents[InNode];
+	Depths[InNode] = (Parent != kInvalidNode) ? Depths[Parent] + 1 : 0;
+
+	ForEachInSubtree(*Transforms[InNode], [this](Transform& InTransform) {
+		const std::uint32_t Node = GetNode(InTransform);
+		if (Parents[Node] != kInvalidNode)
+		{
+			Depths[Node] = Depths[Parents[Node]] + 1;
+		}
+	});
+}
+
+void SceneCore::RemoveNode(Transform& InTransform)
+{
+	const std::uint32_t Node = GetNode(InTransform);
+	if (Node == kInvalidNode)
+	{
+		return;
+	}
+
+	Unlink(Node);
+
+	for (std::uint32_t Child = FirstChildren[Node]; Child != kInvalidNode;)
+	{
+		const std::uint32_t Next = NextSiblings[Child];
+		ChildNameIndex.erase(GetChildNameKey(Node, Transforms[Child]->NameId));
+		Parents[Child] = kInvalidNode;
+		PrevSiblings[Child] = kInvalidNode;
+		NextSiblings[Child] = kInvalidNode;
+		UpdateSubtreeDepth(Child);
+		RefreshFrozen(Child);
+		Transforms[Child]->SetDirty(true);
+		Child = Next;
+	}
+
+	FirstChildren[Node] = kInvalidNode;
+	LastChildren[Node] = kInvalidNode;
+	Depths[Node] = 0;
+	// A pending dirty flag stays until the pass, which skips nodes without a transform
+	FrozenNodes[Node] = 0;
+	ComputedNodes[Node] = 0;
+	RemoveFromNameIndex(Node, InTransform.NameId);
+	Transforms[Node] = nullptr;
+	InTransform.Hierarchy = nullptr;
+	MarkHierarchyChanged();
+
+	if (&InTransform == RootTransform)
 	{
-		transform.ParentTransform->RemoveChild(&transform);
+		RootTransform = nullptr;
 	}
 }
 
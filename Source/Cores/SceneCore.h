@@ -1,18 +1,33 @@
 #pragma once
 #include "ECS/Core.h"
+#include "Math/AffineMatrix.h"
+#include "Utils/StringTable.h"
+#include <atomic>
+#include <unordered_map>
 
 class Transform;
 
 class SceneCore
 	: public Core<SceneCore>
 {
+	friend class Transform;
 public:
+	// Marks a missing parent, child or sibling in the hierarchy arrays
+	static constexpr std::uint32_t kInvalidNode = static_cast<std::uint32_t>(-1);
+
 	SceneCore();
 	~SceneCore();
 
 	// Separate init from construction code.
 	void Init() final;
 
+	// Runs the batched world matrix pass, once per frame before rendering
+	void Update(const UpdateContext& InUpdateContext) final;
+
+	// Freezes static transforms while the game runs, see Transform::SetStatic
+	void OnStart() final;
+	void OnStop() final;
+
 	void OnEntityAdded(Entity& NewEntity) final;
 	void OnEntityRemoved(Entity& InEntity) final;
 	void OnEntityDestroyed(Entity& InEntity) final;
@@ -20,12 +35,224 @@ public:
 	EntityHandle RootTransformEntity;
 	Transform* GetRootTransform();
 
+	// Scene graph, every node is the EntityID::Index of the entity owning the Transform.
+	// Passing nullptr as the parent detaches InChild, it keeps its local values.
+	void SetParent(Transform& InChild, Transform* InParent);
+	Transform* GetParent(const Transform& InChild) const;
+	std::size_t GetChildCount(const Transform& InParent) const;
+	bool HasChildren(const Transform& InParent) const;
+	std::uint32_t GetDepth(const Transform& InTransform) const;
+
+	// Calls InFunc(Transform&) for every direct child of InParent, in the order they were parented
+	template<typename Func>
+	void ForEachChild(const Transform& InParent, Func&& InFunc) const;
+
+	// Calls InFunc(Transform&) for InRoot and everything below it, depth first with parents before their children.
+	// Walks the sibling links without recursion, deep hierarchies don't grow the stack.
+	template<typename Func>
+	void ForEachInSubtree(const Transform& InRoot, Func&& InFunc) const;
+
+	// Every node in the scene sorted by depth, a parent always comes before its children.
+	// Rebuilt lazily after the hierarchy changes.
+	const std::vector<std::uint32_t>& GetDepthSortedNodes();
+
+	Transform* GetTransform(std::uint32_t InNode) const;
+
+	// Name lookups through hash indices kept up to date as transforms are renamed and reparented.
+	// With duplicate names any one of the matches is returned.
+	Transform* FindChild(const Transform& InParent, StringTable::Id InNameId) const;
+	Transform* FindTransform(StringTable::Id InNameId) const;
+	Transform* FindTransform(const std::string& InName) const;
+
+	// Frozen transforms are static ones, or anything below them, while the game is running.
+	// Their world matrix is computed once and they are skipped by the per frame passes until unfrozen.
+	bool IsFrozen(const Transform& InTransform) const;
+
+	// Calls InFunc(Transform&) for every frozen transform, GetMatrix() returns its fixed world matrix. Meant for static batching.
+	template<typename Func>
+	void ForEachFrozen(Func&& InFunc) const;
+
+	// Recomputes the world matrix of every node touched since the last pass and writes it back to its Transform.
+	// Local TRS is gathered into arrays laid out parents first, so each subtree is one linear sweep.
+	// Subtrees hanging off a root are independent and are spread over the job engine when the world has one.
+	void UpdateWorldMatrices();
+
+	// Dirty subtrees are merged into jobs of about this many nodes
+	static constexpr std::size_t kMinNodesPerJob = 512;
+
 #if ME_EDITOR
 	virtual void OnEditorInspect() final;
 #endif
 
 private:
-
 	Transform* RootTransform = nullptr;
 
-};
\ No newline at end of file
+	// Dense per node arrays, indexed by EntityID::Index
+	std::vector<Transform*> Transforms;
+	std::vector<std::uint32_t> Parents;
+	std::vector<std::uint32_t> FirstChildren;
+	std::vector<std::uint32_t> LastChildren;
+	std::vector<std::uint32_t> NextSiblings;
+	std::vector<std::uint32_t> PrevSiblings;
+	std::vector<std::uint32_t> Depths;
+
+	std::vector<std::uint32_t> DepthSortedNodes;
+	bool IsDepthOrderDirty = true;
+
+	// Transforms are moved from jobs as well, so the flag is claimed atomically.
+	// Copyable to let the per node arrays keep growing as plain vectors, which only happens outside of jobs.
+	struct DirtyFlag
+	{
+		std::atomic<std::uint8_t> Value{ 0 };
+
+		DirtyFlag() = default;
+		DirtyFlag(const DirtyFlag& InOther)
+			: Value(InOther.Value.load(std::memory_order_relaxed))
+		{
+		}
+
+		bool IsSet() const
+		{
+			return Value.load(std::memory_order_relaxed) != 0;
+		}
+	};
+
+	// Set by Transform::SetDirty, indexed by node. Only the moved node is flagged, its children are implied.
+	// Flags are only cleared by the pass, so a node is listed in DirtyRoots at most once.
+	std::vector<DirtyFlag> DirtyNodes;
+	// Nodes flagged since the last pass, the first DirtyRootCount entries are valid.
+	// Sized like the node arrays, which the once per pass rule above guarantees is enough.
+	std::vector<std::uint32_t> DirtyRoots;
+	std::atomic<std::uint32_t> DirtyRootCount{ 0 };
+
+	// Indexed by node, recomputed for a subtree whenever a static flag or parent in it changes
+	std::vector<std::uint8_t> FrozenNodes;
+	bool IsFreezingEnabled = false;
+	// Indexed by node, set once a pass has written its world matrix. Nodes are only frozen after that.
+	std::vector<std::uint8_t> ComputedNodes;
+	// Nodes that should be frozen but are still waiting for their first pass, refreshed once it has run
+	std::vector<std::uint32_t> PendingFrozenNodes;
+
+	// Batched pass state, indexed by slot.
+	// Slots start with every parentless node, followed by the subtree of each of their children in depth first order.
+	std::vector<std::uint32_t> SlotNodes;
+	std::vector<std::uint32_t> SlotParents;
+	std::vector<glm::vec3> SlotPositions;
+	std::vector<glm::quat> SlotRotations;
+	std::vector<glm::vec3> SlotScales;
+	std::vector<AffineMatrix> SlotWorldMatrices;
+	// One past the last slot of the subtree starting at each slot, not used for the parentless slots
+	std::vector<std::uint32_t> SlotSubtreeEnds;
+	std::vector<std::uint32_t> NodeSlots;
+	std::uint32_t RootSlotCount = 0;
+	// [Begin, End) slots of everything below each parentless slot, indexed by root slot
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> RootSubtreeRanges;
+	std::vector<std::uint32_t> DirtyRootSlots;
+	// [Begin, End) slot ranges that don't depend on each other, the dirty parentless slots are done before them
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> DirtyRanges;
+	// Set by the jobs for every slot whose world matrix changed, the change ticks are stamped afterwards on one thread
+	std::vector<std::uint8_t> SlotChanged;
+	bool IsBatchLayoutDirty = true;
+
+	void RebuildBatchLayout();
+	void UpdateSlotRanges(const std::vector<std::pair<std::uint32_t, std::uint32_t>>& InRanges);
+	void UpdateSlotRange(std::uint32_t InBegin, std::uint32_t InEnd);
+	void MarkChangedSlots(std::uint32_t InBegin, std::uint32_t InEnd);
+
+	void MarkDirty(const Transform& InTransform);
+	void MarkDirty(std::uint32_t InNode);
+	bool HasDirtyAncestor(std::uint32_t InNode) const;
+
+	void RefreshFrozen(std::uint32_t InNode);
+	void RefreshFrozenRoots();
+	void RefreshPendingFrozen();
+
+	// True when InTransform or anything above it moved since the last pass
+	bool IsDirtyInHierarchy(const Transform& InTransform) const;
+
+	// World matrix of InTransform before the pass has run, walks up to the highest dirty ancestor without recursing
+	AffineMatrix ComputeWorldMatrix(const Transform& InTransform) const;
+	void MarkHierarchyChanged();
+
+	// Returns the node of InTransform, registering it on first use
+	std::uint32_t GetOrAddNode(Transform& InTransform);
+	std::uint32_t GetNode(const Transform& InTransform) const;
+
+	void Unlink(std::uint32_t InNode);
+
+	// Child with a given name per parent, keyed by GetChildNameKey
+	std::unordered_map<std::uint64_t, std::uint32_t> ChildNameIndex;
+	// Every node carrying a given name
+	std::unordered_map<StringTable::Id, std::vector<std::uint32_t>> NameIndex;
+
+	static std::uint64_t GetChildNameKey(std::uint32_t InParent, StringTable::Id InNameId);
+	void AddToNameIndex(std::uint32_t InNode);
+	void RemoveFromNameIndex(std::uint32_t InNode, StringTable::Id InNameId);
+	void AddToChildNameIndex(std::uint32_t InNode);
+	// Falls back to another child with the same name if InNode was the indexed one
+	void RemoveFromChildNameIndex(std::uint32_t InNode, std::uint32_t InParent, StringTable::Id InNameId);
+	void OnNameChanged(Transform& InTransform, StringTable::Id InOldNameId);
+	void UpdateSubtreeDepth(std::uint32_t InNode);
+
+	// Drops InTransform from the hierarchy, its children are detached
+	void RemoveNode(Transform& InTransform);
+};
+
+template<typename Func>
+void SceneCore::ForEachChild(const Transform& InParent, Func&& InFunc) const
+{
+	const std::uint32_t Node = GetNode(InParent);
+	if (Node == kInvalidNode)
+	{
+		return;
+	}
+
+	for (std::uint32_t Child = FirstChildren[Node]; Child != kInvalidNode;)
+	{
+		// Read the link first so InFunc can reparent the child
+		const std::uint32_t Next = NextSiblings[Child];
+		InFunc(*Transforms[Child]);
+		Child = Next;
+	}
+}
+
+template<typename Func>
+void SceneCore::ForEachInSubtree(const Transform& InRoot, Func&& InFunc) const
+{
+	const std::uint32_t Root = GetNode(InRoot);
+	if (Root == kInvalidNode)
+	{
+		return;
+	}
+
+	std::uint32_t Node = Root;
+	while (Node != kInvalidNode)
+	{
+		InFunc(*Transforms[Node]);
+
+		if (FirstChildren[Node] != kInvalidNode)
+		{
+			Node = FirstChildren[Node];
+			continue;
+		}
+
+		// Climb until there's a sibling to move to, stopping at the subtree root
+		while (Node != Root && NextSiblings[Node] == kInvalidNode)
+		{
+			Node = Parents[Node];
+		}
+		Node = (Node == Root) ? kInvalidNode : NextSiblings[Node];
+	}
+}
+
+template<typename Func>
+void SceneCore::ForEachFrozen(Func&& InFunc) const
+{
+	for (std::size_t Node = 0; Node < Transforms.size(); ++Node)
+	{
+		if (Transforms[Node] && FrozenNodes[Node])
+		{
+			InFunc(*Transforms[Node]);
+		}
+	}
+}
@@ -0,0 +1,199 @@
+#include "PCH.h"
+#include "Archetype.h"
+
+Archetype::Archetype(const ComponentTypeArray& InSignature)
+	: Signature(InSignature)
+{
+	for (std::size_t i = 0; i < Signature.size(); ++i)
+	{
+		if (Signature[i])
+		{
+			Types.push_back(i);
+		}
+	}
+
+	if (!Types.empty())
+	{
+		ColumnLookup.resize(Types.back() + 1, -1);
+		for (std::size_t i = 0; i < Types.size(); ++i)
+		{
+			ColumnLookup[Types[i]] = static_cast<int>(i);
+		}
+	}
+
+	const std::size_t rowSize = sizeof(CoreTypeArray) + sizeof(EntityID) + sizeof(std::uint8_t) + Types.size() * (sizeof(SharedPtr<BaseComponent>) + 2 * sizeof(std::uint32_t));
+	ChunkCapacity = std::max<std::size_t>(kChunkBytes / rowSize, 1);
+}
+
+Archetype::~Archetype()
+{
+}
+
+const ComponentTypeArray& Archetype::GetSignature() const
+{
+	return Signature;
+}
+
+const std::vector<TypeId>& Archetype::GetTypes() const
+{
+	return Types;
+}
+
+std::size_t Archetype::Add(const EntityID& InEntity)
+{
+	if (Chunks.empty() || Chunks.back().Size() == ChunkCapacity)
+	{
+		Chunks.emplace_back(ChunkCapacity, Types.size());
+	}
+
+	Chunks.back().PushBack(InEntity);
+	return Count++;
+}
+
+EntityID Archetype::Remove(std::size_t InRow)
+{
+	const std::size_t lastRow = Count - 1;
+	Chunk& lastChunk = Chunks[lastRow / ChunkCapacity];
+	const std::size_t lastIndex = lastRow % ChunkCapacity;
+
+	EntityID movedEntity;
+	if (InRow != lastRow)
+	{
+		Chunk& chunk = Chunks[InRow / ChunkCapacity];
+		const std::size_t index = InRow % ChunkCapacity;
+
+		movedEntity = lastChunk.GetEntities()[lastIndex];
+		chunk.GetEntities()[index] = movedEntity;
+		chunk.GetActiveFlags()[index] = lastChunk.GetActiveFlags()[lastIndex];
+		chunk.GetCoreMasks()[index] = lastChunk.GetCoreMasks()[lastIndex];
+		for (int i = 0; i < static_cast<int>(Types.size()); ++i)
+		{
+			chunk.GetColumn(i)[index] = std::move(lastChunk.GetColumn(i)[lastIndex]);
+			chunk.GetChangedTicks(i)[index] = lastChunk.GetChangedTicks(i)[lastIndex];
+			chunk.GetAddedTicks(i)[index] = lastChunk.GetAddedTicks(i)[lastIndex];
+			chunk.GetColumnTicks()[i] = std::max(chunk.GetColumnTicks()[i], chunk.GetChangedTicks(i)[index]);
+		}
+	}
+
+	lastChunk.PopBack();
+	if (lastChunk.Size() == 0)
+	{
+		Chunks.pop_back();
+	}
+
+	--Count;
+	return movedEntity;
+}
+
+std::size_t Archetype::GetCount() const
+{
+	return Count;
+}
+
+std::size_t Archetype::GetChunkCapacity() const
+{
+	return ChunkCapacity;
+}
+
+std::size_t Archetype::GetChunkCount() const
+{
+	return Chunks.size();
+}
+
+Archetype::Chunk& Archetype::GetChunk(std::size_t InIndex)
+{
+	return Chunks[InIndex];
+}
+
+const Archetype::Chunk& Archetype::GetChunk(std::size_t InIndex) const
+{
+	return Chunks[InIndex];
+}
+
+Archetype* Archetype::GetAddEdge(TypeId InTypeId) const
+{
+	return InTypeId < AddEdges.size() ? AddEdges[InTypeId] : nullptr;
+}
+
+Archetype* Archetype::GetRemoveEdge(TypeId InTypeId) const
+{
+	return InTypeId < RemoveEdges.size() ? RemoveEdges[InTypeId] : nullptr;
+}
+
+void Archetype::SetAddEdge(TypeId InTypeId, Archetype* InArchetype)
+{
+	CheckCapacity(AddEdges, InTypeId);
+	AddEdges[InTypeId] = InArchetype;
+}
+
+void Archetype::SetRemoveEdge(TypeId InTypeId, Archetype* InArchetype)
+{
+	CheckCapacity(RemoveEdges, InTypeId);
+	RemoveEdges[InTypeId] = InArchetype;
+}
+
+Archetype::Chunk::Chunk(std::size_t InCapacity, std::size_t InColumnCount)
+	: Capacity(InCapacity)
+	, ColumnCount(InColumnCount)
+{
+	static_assert(alignof(CoreTypeArray) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Core masks lead the block and rely on new's alignment");
+	static_assert(alignof(SharedPtr<BaseComponent>) <= alignof(CoreTypeArray), "Chunk layout assumes core masks have the strictest alignment");
+	static_assert(alignof(EntityID) <= alignof(SharedPtr<BaseComponent>), "Chunk layout assumes pointers come next");
+	static_assert(alignof(std::uint32_t) <= alignof(EntityID), "Chunk layout assumes ticks need the least alignment after ids");
+
+	ColumnsOffset = Capacity * sizeof(CoreTypeArray);
+	EntitiesOffset = ColumnsOffset + Capacity * ColumnCount * sizeof(SharedPtr<BaseComponent>);
+	TicksOffset = EntitiesOffset + Capacity * sizeof(EntityID);
+	const std::size_t tickCount = Capacity * ColumnCount * 2 + ColumnCount;
+	ActiveOffset = TicksOffset + tickCount * sizeof(std::uint32_t);
+	Block.reset(new unsigned char[ActiveOffset + Capacity * sizeof(std::uint8_t)]);
+
+	std::fill_n(GetColumnTicks(), ColumnCount, 0u);
+}
+
+Archetype::Chunk::~Chunk()
+{
+	while (Count > 0)
+	{
+		PopBack();
+	}
+}
+
+Archetype::Chunk::Chunk(Chunk&& InOther) noexcept
+	: Block(std::move(InOther.Block))
+	, Capacity(InOther.Capacity)
+	, ColumnCount(InOther.ColumnCount)
+	, Count(InOther.Count)
+	, ColumnsOffset(InOther.ColumnsOffset)
+	, EntitiesOffset(InOther.EntitiesOffset)
+	, TicksOffset(InOther.TicksOffset)
+	, ActiveOffset(InOther.ActiveOffset)
+{
+	InOther.Count = 0;
+}
+
+std::size_t Archetype::Chunk::PushBack(const EntityID& InEntity)
+{
+	const std::size_t row = Count++;
+	new(&GetEntities()[row]) EntityID(InEntity);
+	new(&GetCoreMasks()[row]) CoreTypeArray();
+	GetActiveFlags()[row] = 0;
+	for (int i = 0; i < static_cast<int>(ColumnCount); ++i)
+	{
+		new(&GetColumn(i)[row]) SharedPtr<BaseComponent>();
+		GetChangedTicks(i)[row] = 0;
+		GetAddedTicks(i)[row] = 0;
+	}
+	return row;
+}
+
+void Archetype::Chunk::PopBack()
+{
+	const std::size_t row = --Count;
+	for (int i = 0; i < static_cast<int>(ColumnCount); ++i)
+	{
+		std::destroy_at(&GetColumn(i)[row]);
+	}
+	std::destroy_at(&GetEntities()[row]);
+	std::destroy_at(&GetCoreMasks()[row]);
+}
@@ -0,0 +1,239 @@
+#pragma once
+#include <vector>
+#include <memory>
+
+#include "ECS/Component.h"
+#include "ECS/ComponentTypeArray.h"
+#include "ECS/EntityID.h"
+
+#include "Dementia.h"
+
+// Every entity with the same component signature lives in the same archetype.
+// Entities are packed into fixed size chunks and each component type gets its own
+// contiguous column inside of a chunk, so walking one component type is a linear read.
+// Components are polymorphic and referenced by address all over the engine (scene graph, cameras, physics),
+// so the columns hold owning pointers into the per type component pools rather than the objects themselves.
+// That keeps component addresses stable when rows move between chunks or archetypes.
+class Archetype
+{
+public:
+	// Rough memory budget of a single chunk, used to figure out how many entities fit.
+	static constexpr std::size_t kChunkBytes = 16 * 1024;
+
+	// Everything a chunk stores lives in one allocation, laid out as
+	// [core masks][component pointers per column][entity ids][changed ticks per column][added ticks per column][column ticks][active flags]
+	class Chunk
+	{
+	public:
+		Chunk(std::size_t InCapacity, std::size_t InColumnCount);
+		~Chunk();
+		Chunk(Chunk&& InOther) noexcept;
+
+		ME_NONCOPYABLE(Chunk)
+		ME_DISABLE_MOVE_ASSIGNMENT(Chunk)
+
+		std::size_t Size() const
+		{
+			return Count;
+		}
+
+		// Appends an inactive row with empty component slots, zeroed ticks and no cores, returns its index
+		std::size_t PushBack(const EntityID& InEntity);
+		void PopBack();
+
+		SharedPtr<BaseComponent>* GetColumn(int InColumn)
+		{
+			return reinterpret_cast<SharedPtr<BaseComponent>*>(Block.get() + ColumnsOffset) + Capacity * InColumn;
+		}
+
+		const SharedPtr<BaseComponent>* GetColumn(int InColumn) const
+		{
+			return reinterpret_cast<const SharedPtr<BaseComponent>*>(Block.get() + ColumnsOffset) + Capacity * InColumn;
+		}
+
+		const EntityID* GetEntities() const
+		{
+			return reinterpret_cast<const EntityID*>(Block.get() + EntitiesOffset);
+		}
+
+		EntityID* GetEntities()
+		{
+			return reinterpret_cast<EntityID*>(Block.get() + EntitiesOffset);
+		}
+
+		// Per column and row, the world change tick of the last write and of when the component was added
+		std::uint32_t* GetChangedTicks(int InColumn)
+		{
+			return GetTicks() + Capacity * InColumn;
+		}
+
+		const std::uint32_t* GetChangedTicks(int InColumn) const
+		{
+			return GetTicks() + Capacity * InColumn;
+		}
+
+		std::uint32_t* GetAddedTicks(int InColumn)
+		{
+			return GetTicks() + Capacity * (ColumnCount + InColumn);
+		}
+
+		const std::uint32_t* GetAddedTicks(int InColumn) const
+		{
+			return GetTicks() + Capacity * (ColumnCount + InColumn);
+		}
+
+		// Newest changed tick of every column, lets queries skip untouched chunks
+		std::uint32_t* GetColumnTicks()
+		{
+			return GetTicks() + Capacity * ColumnCount * 2;
+		}
+
+		const std::uint32_t* GetColumnTicks() const
+		{
+			return GetTicks() + Capacity * ColumnCount * 2;
+		}
+
+		// Per row, whether the entity is active and which cores it is registered with.
+		// Mirrored from World so queries filter rows without leaving the chunk.
+		std::uint8_t* GetActiveFlags()
+		{
+			return Block.get() + ActiveOffset;
+		}
+
+		const std::uint8_t* GetActiveFlags() const
+		{
+			return Block.get() + ActiveOffset;
+		}
+
+		CoreTypeArray* GetCoreMasks()
+		{
+			return reinterpret_cast<CoreTypeArray*>(Block.get());
+		}
+
+		const CoreTypeArray* GetCoreMasks() const
+		{
+			return reinterpret_cast<const CoreTypeArray*>(Block.get());
+		}
+
+	private:
+		std::unique_ptr<unsigned char[]> Block;
+		std::size_t Capacity = 0;
+		std::size_t ColumnCount = 0;
+		std::size_t Count = 0;
+		std::size_t ColumnsOffset = 0;
+		std::size_t EntitiesOffset = 0;
+		std::size_t TicksOffset = 0;
+		std::size_t ActiveOffset = 0;
+
+		std::uint32_t* GetTicks()
+		{
+			return reinterpret_cast<std::uint32_t*>(Block.get() + TicksOffset);
+		}
+
+		const std::uint32_t* GetTicks() const
+		{
+			return reinterpret_cast<const std::uint32_t*>(Block.get() + TicksOffset);
+		}
+	};
+
+	Archetype(const ComponentTypeArray& InSignature);
+	~Archetype();
+
+	ME_NONCOPYABLE(Archetype)
+	ME_NONMOVABLE(Archetype)
+
+	const ComponentTypeArray& GetSignature() const;
+
+	// Sorted list of the component types stored in this archetype.
+	const std::vector<TypeId>& GetTypes() const;
+
+	// Returns the column index of a component type or -1 if the archetype doesn't store it.
+	inline int GetColumn(TypeId InTypeId) const
+	{
+		return InTypeId < ColumnLookup.size() ? ColumnLookup[InTypeId] : -1;
+	}
+
+	// Append an entity with empty component slots, returns the row it was placed in.
+	std::size_t Add(const EntityID& InEntity);
+
+	// Swap and pop the row, returns the id of the entity that now occupies InRow or a null id if nothing moved.
+	EntityID Remove(std::size_t InRow);
+
+	inline SharedPtr<BaseComponent>& GetComponent(std::size_t InRow, int InColumn)
+	{
+		return Chunks[InRow / ChunkCapacity].GetColumn(InColumn)[InRow % ChunkCapacity];
+	}
+
+	inline const EntityID& GetEntity(std::size_t InRow) const
+	{
+		return Chunks[InRow / ChunkCapacity].GetEntities()[InRow % ChunkCapacity];
+	}
+
+	inline void MarkChanged(std::size_t InRow, int InColumn, std::uint32_t InTick)
+	{
+		Chunk& chunk = Chunks[InRow / ChunkCapacity];
+		chunk.GetChangedTicks(InColumn)[InRow % ChunkCapacity] = InTick;
+		if (InTick > chunk.GetColumnTicks()[InColumn])
+		{
+			chunk.GetColumnTicks()[InColumn] = InTick;
+		}
+	}
+
+	inline void MarkAdded(std::size_t InRow, int InColumn, std::uint32_t InTick)
+	{
+		Chunks[InRow / ChunkCapacity].GetAddedTicks(InColumn)[InRow % ChunkCapacity] = InTick;
+		MarkChanged(InRow, InColumn, InTick);
+	}
+
+	inline std::uint32_t GetChangedTick(std::size_t InRow, int InColumn) const
+	{
+		return Chunks[InRow / ChunkCapacity].GetChangedTicks(InColumn)[InRow % ChunkCapacity];
+	}
+
+	inline std::uint32_t GetAddedTick(std::size_t InRow, int InColumn) const
+	{
+		return Chunks[InRow / ChunkCapacity].GetAddedTicks(InColumn)[InRow % ChunkCapacity];
+	}
+
+	inline void SetRowState(std::size_t InRow, bool InIsActive, const CoreTypeArray& InCores)
+	{
+		Chunk& chunk = Chunks[InRow / ChunkCapacity];
+		chunk.GetActiveFlags()[InRow % ChunkCapacity] = InIsActive;
+		chunk.GetCoreMasks()[InRow % ChunkCapacity] = InCores;
+	}
+
+	inline bool IsRowActive(std::size_t InRow) const
+	{
+		return Chunks[InRow / ChunkCapacity].GetActiveFlags()[InRow % ChunkCapacity] != 0;
+	}
+
+	inline const CoreTypeArray& GetRowCores(std::size_t InRow) const
+	{
+		return Chunks[InRow / ChunkCapacity].GetCoreMasks()[InRow % ChunkCapacity];
+	}
+
+	std::size_t GetCount() const;
+	std::size_t GetChunkCapacity() const;
+
+	std::size_t GetChunkCount() const;
+	Chunk& GetChunk(std::size_t InIndex);
+	const Chunk& GetChunk(std::size_t InIndex) const;
+
+	// Cached graph edges so repeated add/remove transitions skip the signature lookup.
+	Archetype* GetAddEdge(TypeId InTypeId) const;
+	Archetype* GetRemoveEdge(TypeId InTypeId) const;
+	void SetAddEdge(TypeId InTypeId, Archetype* InArchetype);
+	void SetRemoveEdge(TypeId InTypeId, Archetype* InArchetype);
+
+private:
+	ComponentTypeArray Signature;
+	std::vector<TypeId> Types;
+	std::vector<int> ColumnLookup;
+
+	std::vector<Chunk> Chunks;
+	std::size_t ChunkCapacity = 0;
+	std::size_t Count = 0;
+
+	std::vector<Archetype*> AddEdges;
+	std::vector<Archetype*> RemoveEdges;
+};
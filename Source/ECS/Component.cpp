@@ -1,2 +1,44 @@
 #include "PCH.h"
 #include "Component.h"
+#include "Engine/World.h"
+#include <mutex>
+#include <unordered_set>
+
+const std::string& BaseComponent::InternTypeName(const char* InName)
+{
+	static std::mutex Lock;
+	// Leaked on purpose, components can outlive static destruction
+	static std::unordered_set<std::string>* Names = new std::unordered_set<std::string>();
+
+	std::string name(InName);
+	name = name.substr(name.find(' ') + 1);
+
+	std::lock_guard<std::mutex> guard(Lock);
+	return *Names->insert(std::move(name)).first;
+}
+
+void BaseComponent::MarkChanged(TypeId InTypeId)
+{
+	if (World* GameWorld = Parent.GetWorld())
+	{
+		GameWorld->MarkComponentChanged(Parent.GetId(), InTypeId);
+	}
+}
+
+void BaseComponent::SaveSnapshot(SnapshotWriter& Out)
+{
+	json State;
+	Serialize(State);
+
+	const std::vector<std::uint8_t> Packed = json::to_msgpack(State);
+	Out.Write(static_cast<std::uint32_t>(Packed.size()));
+	Out.WriteBytes(Packed.data(), Packed.size());
+}
+
+void BaseComponent::LoadSnapshot(SnapshotReader& In)
+{
+	const std::uint32_t Size = In.Read<std::uint32_t>();
+	const std::uint8_t* Packed = In.GetCursor();
+	In.Skip(Size);
+	Deserialize(json::from_msgpack(Packed, Packed + Size));
+}
@@ -5,7 +5,14 @@
 #include "Dementia.h"
 
 #include "EntityHandle.h"
+#include "ComponentSnapshot.h"
 #include "JSON.h"
+#include "Memory/PoolAllocator.h"
+
+// Extra alignment for pooled component blocks, set to 64 to keep components on their own cache lines.
+#ifndef ME_COMPONENT_ALIGNMENT
+#define ME_COMPONENT_ALIGNMENT 0
+#endif
 
 #define ME_REGISTER_COMPONENT_FOLDER(TYPE, FOLDER)            \
 	namespace details {                                       \
@@ -32,9 +39,8 @@ class BaseComponent
 public:
 	BaseComponent() = delete;
 	BaseComponent(const char* CompName)
-		: TypeName(CompName)
+		: TypeName(&InternTypeName(CompName))
 	{
-		TypeName = TypeName.substr(TypeName.find(' ') + 1);
 	}
 
 	virtual ~BaseComponent() = default;
@@ -44,20 +50,42 @@ public:
 
 	const std::string& GetName() const
 	{
-		return TypeName;
+		return *TypeName;
 	}
 
 	EntityHandle Parent;
 
+	// Stamp this component as written for change tracking queries (see ComponentQuery::Changed)
+	void MarkChanged(TypeId InTypeId);
+
 	virtual void Serialize(json& outJson) = 0;
 	virtual void Deserialize(const json& inJson) = 0;
 
+	// Raw state for World::Snapshot, restored onto a fresh or existing instance of the same type.
+	// Engine components override both with raw reads and writes. The default packs Serialize into a binary json blob,
+	// a fallback for game components that don't override them.
+	virtual void SaveSnapshot(SnapshotWriter& Out);
+	virtual void LoadSnapshot(SnapshotReader& In);
+
+	// Called once every snapshot component is back in the world, before Init. Use it to resolve references to other entities.
+	virtual void OnSnapshotRestored() {}
+
 #if ME_EDITOR
 	virtual void OnEditorInspect() = 0;
 #endif
 
+protected:
+	// For types that resolved their interned name up front, see Component<T>
+	BaseComponent(const std::string* InTypeName)
+		: TypeName(InTypeName)
+	{
+	}
+
+	static const std::string& InternTypeName(const char* InName);
+
 private:
-	std::string TypeName;
+	// Shared by every instance with the same name
+	const std::string* TypeName;
 };
 
 template<typename T>
@@ -66,7 +94,7 @@ class Component
 {
 public:
 	Component(const char* Name)
-		: BaseComponent(Name)
+		: BaseComponent(GetInternedName(Name))
 	{
 	}
 
@@ -75,6 +103,15 @@ public:
 		return ClassTypeId<BaseComponent>::GetTypeId<T>();
 	}
 
+	void MarkChanged()
+	{
+		BaseComponent::MarkChanged(GetTypeId());
+	}
+
+	// Types whose setters call MarkChanged themselves hide this with true,
+	// queries then leave their change ticks alone instead of stamping every visited row
+	static constexpr bool kMarksOwnChanges = false;
+
 	// OnDeserialize guaranteed to be called before this
 	virtual void Init() override {};
 
@@ -99,6 +136,26 @@ public:
 private:
 	virtual void OnSerialize(json& outJson) = 0;
 	virtual void OnDeserialize(const json& inJson) = 0;
+
+	// Nearly every T always passes the same literal, intern it on the first construction only.
+	// Types that forward a name from a subclass (BasicUIView) still get theirs looked up.
+	static const std::string* GetInternedName(const char* InName)
+	{
+		static const char* const FirstName = InName;
+		static const std::string* const Interned = &InternTypeName(InName);
+		if (InName == FirstName)
+		{
+			return Interned;
+		}
+		return &InternTypeName(InName);
+	}
 };
 
 using ComponentArray = std::vector<std::reference_wrapper<BaseComponent>>;
+
+// Components and their shared pointer control block live in one block of a per-size pool.
+template<typename T, typename... Args>
+inline SharedPtr<T> MakeComponent(Args&&... InArgs)
+{
+	return std::allocate_shared<T>(PoolAllocator<T, ME_COMPONENT_ALIGNMENT>(), std::forward<Args>(InArgs)...);
+}
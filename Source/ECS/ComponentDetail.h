@@ -25,6 +25,26 @@ inline ComponentRegistry& GetComponentRegistry()
 	return reg;
 }
 
+// Registry entry for a component TypeId, skips the name lookup for code that already knows the type.
+inline const ComponentInfo* GetComponentInfo(TypeId InTypeId)
+{
+	// Components register during static init, so the table can be built once on first use
+	static const std::vector<const ComponentInfo*> ByType = []() {
+		std::vector<const ComponentInfo*> table;
+		for (const auto& entry : GetComponentRegistry())
+		{
+			const TypeId Id = entry.second.GetTypeFunc();
+			if (Id >= table.size())
+			{
+				table.resize(Id + 1, nullptr);
+			}
+			table[Id] = &entry.second;
+		}
+		return table;
+	}();
+	return InTypeId < ByType.size() ? ByType[InTypeId] : nullptr;
+}
+
 template<class T>
 BaseComponent* AddComponent(Entity& inEnt) {
 	return &inEnt.AddComponent<T>();
@@ -3,18 +3,18 @@
 
 bool ComponentFilter::PassFilter(const ComponentTypeArray& InComponentTypeArray) const
 {
-	if ((InComponentTypeArray & RequiredComponentsList) != RequiredComponentsList)
+	if (!InComponentTypeArray.ContainsAll(RequiredComponentsList))
 	{
 		return false;
 	}
 
-	if ((InComponentTypeArray & RequiresOneOfComponentsList).any())
+	if (InComponentTypeArray.Intersects(RequiresOneOfComponentsList))
 	{
 		return true;
 	}
 
 	// Exclude any components we don't want
-	if ((ExcludeComponentsList & InComponentTypeArray).any())
+	if (InComponentTypeArray.Intersects(ExcludeComponentsList))
 	{
 		return false;
 	}
@@ -22,9 +22,50 @@ bool ComponentFilter::PassFilter(const ComponentTypeArray& InComponentTypeArray)
 	return true;
 }
 
+std::size_t ComponentFilter::PassFilter(const ComponentTypeArray* InSignatures, std::size_t InCount, bool* OutPassed) const
+{
+	std::size_t passCount = 0;
+	for (std::size_t i = 0; i < InCount; ++i)
+	{
+		bool containsAll = false;
+		bool hasOneOf = false;
+		bool hasExcluded = false;
+		InSignatures[i].Match(RequiredComponentsList, RequiresOneOfComponentsList, ExcludeComponentsList, containsAll, hasOneOf, hasExcluded);
+		const bool passed = containsAll && (hasOneOf || !hasExcluded);
+		OutPassed[i] = passed;
+		passCount += passed ? 1 : 0;
+	}
+	return passCount;
+}
+
+bool ComponentFilter::ConflictsWith(const ComponentFilter& InOther) const
+{
+	if (!HasAccessInfo || !InOther.HasAccessInfo)
+	{
+		return true;
+	}
+
+	// Only one core of a wave runs on the main thread
+	if (IsMainThreadOnly && InOther.IsMainThreadOnly)
+	{
+		return true;
+	}
+
+	if (WriteComponentsList.Intersects(InOther.WriteComponentsList | InOther.ReadComponentsList))
+	{
+		return true;
+	}
+
+	return InOther.WriteComponentsList.Intersects(ReadComponentsList);
+}
+
 void ComponentFilter::Clear()
 {
 	RequiredComponentsList.reset();
 	RequiresOneOfComponentsList.reset();
 	ExcludeComponentsList.reset();
+	ReadComponentsList.reset();
+	WriteComponentsList.reset();
+	HasAccessInfo = false;
+	IsMainThreadOnly = false;
 }
\ No newline at end of file
@@ -31,8 +31,47 @@ public:
 		ExcludeComponentsList[C::GetTypeId()] = true;
 		return *this;
 	}
+	// Declare which component types a core reads or writes during Update/LateUpdate.
+	// Cores that declare their access can be updated in parallel with cores they don't conflict with,
+	// cores that declare nothing are treated as touching everything and always run on their own.
+	template<typename C>
+	ComponentFilter& Reads()
+	{
+		static_assert(std::is_base_of<BaseComponent, C>(), "C doesn't inherit from Component");
+		ReadComponentsList[C::GetTypeId()] = true;
+		HasAccessInfo = true;
+		return *this;
+	}
+	template<typename C>
+	ComponentFilter& Writes()
+	{
+		static_assert(std::is_base_of<BaseComponent, C>(), "C doesn't inherit from Component");
+		WriteComponentsList[C::GetTypeId()] = true;
+		HasAccessInfo = true;
+		return *this;
+	}
+
+	// For cores that call into systems which aren't thread safe (resource cache, audio, UI), they are only ever updated on the main thread.
+	// Two of them never share a wave.
+	ComponentFilter& RunsOnMainThread()
+	{
+		IsMainThreadOnly = true;
+		return *this;
+	}
+
+	bool RequiresMainThread() const
+	{
+		return IsMainThreadOnly;
+	}
+
 	bool PassFilter(const ComponentTypeArray& InComponentTypeArray) const;
 
+	// Test a batch of signatures in one go, OutPassed[i] is set for every signature that passes. Returns the pass count.
+	std::size_t PassFilter(const ComponentTypeArray* InSignatures, std::size_t InCount, bool* OutPassed) const;
+
+	// True if both filters can't safely be updated at the same time
+	bool ConflictsWith(const ComponentFilter& InOther) const;
+
 	void Clear();
 
 private:
@@ -41,4 +80,12 @@ private:
 	ComponentTypeArray RequiresOneOfComponentsList;
 
 	ComponentTypeArray ExcludeComponentsList;
+
+	ComponentTypeArray ReadComponentsList;
+
+	ComponentTypeArray WriteComponentsList;
+
+	bool HasAccessInfo = false;
+
+	bool IsMainThreadOnly = false;
 };
@@ -0,0 +1,293 @@
+#pragma once
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "ECS/Archetype.h"
+#include "ECS/ComponentFilter.h"
+#include "ECS/ComponentStorage.h"
+#include "Engine/World.h"
+#include "Work/Burst.h"
+#include "Work/JobEngine.h"
+#include "optick.h"
+
+// Iterates every entity that owns all of Ts... by walking the matching archetype chunks directly.
+// The callback receives the components, optionally preceded by the EntityID:
+//     GameWorld.Query<Transform, Mesh>().Excludes<Light>().Each([](Transform& t, Mesh& m) { ... });
+//     GameWorld.Query<Transform>().Each([](const EntityID& id, Transform& t) { ... });
+// Structural changes (adding/removing components, destroying entities) are not allowed while iterating.
+// Components requested as non-const are treated as written and get their change tick bumped for every visited row,
+// ask for const types where the callback only reads:
+//     GameWorld.Query<Transform, const Mesh>().Changed<Transform>(GetLastUpdateTick()).Each(...);
+// Types with kMarksOwnChanges (Transform) are the exception, only rows their setters actually wrote are stamped.
+template<typename... Ts>
+class ComponentQuery
+{
+	static_assert(sizeof...(Ts) > 0, "A query needs at least one component type");
+
+	static constexpr std::size_t kMaxTickFilters = 4;
+
+public:
+	ComponentQuery(World& InWorld)
+		: GameWorld(InWorld)
+	{
+		(Filter.Requires<std::remove_const_t<Ts>>(), ...);
+	}
+
+	// Only visit rows whose C was written or added after InSinceTick (usually BaseCore::GetLastUpdateTick()).
+	// Changed and Added filters combine, a row is visited if any of them passes.
+	template<typename C>
+	ComponentQuery& Changed(std::uint32_t InSinceTick)
+	{
+		AddTickFilter<C>(InSinceTick, false);
+		return *this;
+	}
+
+	// Only visit rows whose C was added after InSinceTick.
+	template<typename C>
+	ComponentQuery& Added(std::uint32_t InSinceTick)
+	{
+		AddTickFilter<C>(InSinceTick, true);
+		return *this;
+	}
+
+	template<typename C>
+	ComponentQuery& RequiresOneOf()
+	{
+		Filter.RequiresOneOf<C>();
+		return *this;
+	}
+
+	template<typename C>
+	ComponentQuery& Excludes()
+	{
+		Filter.Excludes<C>();
+		return *this;
+	}
+
+	// Only visit entities that are currently registered with the given core.
+	template<typename TCore>
+	ComponentQuery& MemberOf()
+	{
+		CoreId = TCore::GetTypeId();
+		HasCoreFilter = true;
+		return *this;
+	}
+
+	// By default only active entities are visited.
+	ComponentQuery& IncludeInactive(bool InIncludeInactive = true)
+	{
+		VisitInactive = InIncludeInactive;
+		return *this;
+	}
+
+	template<typename Func>
+	void Each(Func&& InFunc)
+	{
+		OPTICK_EVENT("ComponentQuery::Each");
+		for (const UniquePtr<Archetype>& arch : GameWorld.EntityAttributes.Storage.GetArchetypes())
+		{
+			if (!Filter.PassFilter(arch->GetSignature()))
+			{
+				continue;
+			}
+
+			for (std::size_t i = 0; i < arch->GetChunkCount(); ++i)
+			{
+				RunChunk(*arch, arch->GetChunk(i), InFunc, std::index_sequence_for<Ts...>{});
+			}
+		}
+	}
+
+	// Same as Each but the matching chunks are split over the job engine, InFunc must be safe to call concurrently.
+	// Queries matching a single chunk run inline.
+	template<typename Func>
+	void ParallelEach(JobEngine& InJobEngine, Func&& InFunc)
+	{
+		OPTICK_EVENT("ComponentQuery::ParallelEach");
+		std::size_t chunkCount = 0;
+		for (const UniquePtr<Archetype>& arch : GameWorld.EntityAttributes.Storage.GetArchetypes())
+		{
+			if (Filter.PassFilter(arch->GetSignature()))
+			{
+				chunkCount += arch->GetChunkCount();
+			}
+		}
+
+		Burst::ParallelFor(InJobEngine, 0, chunkCount, 1, [this, &InFunc](std::size_t InBegin, std::size_t InEnd) {
+			RunChunks(InBegin, InEnd, InFunc);
+		});
+	}
+
+	std::size_t Count()
+	{
+		std::size_t count = 0;
+		for (const UniquePtr<Archetype>& arch : GameWorld.EntityAttributes.Storage.GetArchetypes())
+		{
+			if (!Filter.PassFilter(arch->GetSignature()))
+			{
+				continue;
+			}
+
+			for (std::size_t i = 0; i < arch->GetChunkCount(); ++i)
+			{
+				VisitRows(*arch, arch->GetChunk(i), [&count](std::size_t) {
+					++count;
+				});
+			}
+		}
+		return count;
+	}
+
+private:
+	World& GameWorld;
+	ComponentFilter Filter;
+	TypeId CoreId = 0;
+	bool HasCoreFilter = false;
+	bool VisitInactive = false;
+
+	struct TickFilter
+	{
+		TypeId Type;
+		std::uint32_t SinceTick;
+		bool Added;
+	};
+	TickFilter TickFilters[kMaxTickFilters];
+	std::size_t TickFilterCount = 0;
+
+	template<typename C>
+	void AddTickFilter(std::uint32_t InSinceTick, bool InAdded)
+	{
+		assert(TickFilterCount < kMaxTickFilters && "Too many Changed/Added filters on one query");
+		Filter.Requires<C>();
+		TickFilters[TickFilterCount++] = { C::GetTypeId(), InSinceTick, InAdded };
+	}
+
+	template<typename T>
+	static void MarkWritten(Archetype::Chunk& InChunk, int InColumn, std::size_t InRow, std::uint32_t InTick)
+	{
+		if constexpr (!std::is_const_v<T> && !T::kMarksOwnChanges)
+		{
+			InChunk.GetChangedTicks(InColumn)[InRow] = InTick;
+			if (InTick > InChunk.GetColumnTicks()[InColumn])
+			{
+				InChunk.GetColumnTicks()[InColumn] = InTick;
+			}
+		}
+	}
+
+	// Reads the row state World mirrors into the chunk, no per entity lookups
+	bool ShouldVisit(const Archetype::Chunk& InChunk, std::size_t InRow) const
+	{
+		if (!VisitInactive && !InChunk.GetActiveFlags()[InRow])
+		{
+			return false;
+		}
+		return !HasCoreFilter || (CoreId < ME_MAX_CORE_TYPES && InChunk.GetCoreMasks()[InRow][CoreId]);
+	}
+
+	bool PassTickFilters(const Archetype::Chunk& InChunk, const int* InColumns, std::size_t InRow) const
+	{
+		if (TickFilterCount == 0)
+		{
+			return true;
+		}
+
+		for (std::size_t i = 0; i < TickFilterCount; ++i)
+		{
+			const std::uint32_t* ticks = TickFilters[i].Added ? InChunk.GetAddedTicks(InColumns[i]) : InChunk.GetChangedTicks(InColumns[i]);
+			if (ticks[InRow] > TickFilters[i].SinceTick)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Calls InRowFunc(row) for every row of the chunk that passes the activity and tick filters
+	template<typename RowFunc>
+	void VisitRows(const Archetype& InArchetype, const Archetype::Chunk& InChunk, RowFunc&& InRowFunc) const
+	{
+		int tickColumns[kMaxTickFilters];
+		bool chunkChanged = TickFilterCount == 0;
+		for (std::size_t i = 0; i < TickFilterCount; ++i)
+		{
+			tickColumns[i] = InArchetype.GetColumn(TickFilters[i].Type);
+			chunkChanged |= InChunk.GetColumnTicks()[tickColumns[i]] > TickFilters[i].SinceTick;
+		}
+
+		// Nothing in this chunk was written since the filters' ticks
+		if (!chunkChanged)
+		{
+			return;
+		}
+
+		const std::size_t count = InChunk.Size();
+		for (std::size_t row = 0; row < count; ++row)
+		{
+			if (ShouldVisit(InChunk, row) && PassTickFilters(InChunk, tickColumns, row))
+			{
+				InRowFunc(row);
+			}
+		}
+	}
+
+	// Runs the matching chunks [InBegin, InEnd), numbered across archetypes in storage order
+	template<typename Func>
+	void RunChunks(std::size_t InBegin, std::size_t InEnd, Func& InFunc) const
+	{
+		std::size_t first = 0;
+		for (const UniquePtr<Archetype>& arch : GameWorld.EntityAttributes.Storage.GetArchetypes())
+		{
+			if (first >= InEnd)
+			{
+				return;
+			}
+			if (!Filter.PassFilter(arch->GetSignature()))
+			{
+				continue;
+			}
+
+			const std::size_t last = first + arch->GetChunkCount();
+			for (std::size_t i = std::max(first, InBegin); i < std::min(last, InEnd); ++i)
+			{
+				RunChunk(*arch, arch->GetChunk(i - first), InFunc, std::index_sequence_for<Ts...>{});
+			}
+			first = last;
+		}
+	}
+
+	template<typename Func, std::size_t... I>
+	void RunChunk(const Archetype& InArchetype, Archetype::Chunk& InChunk, Func& InFunc, std::index_sequence<I...>) const
+	{
+		const int columnIds[] = { InArchetype.GetColumn(std::remove_const_t<Ts>::GetTypeId())... };
+		const SharedPtr<BaseComponent>* columns[] = { InChunk.GetColumn(columnIds[I])... };
+
+		const std::uint32_t tick = GameWorld.EntityAttributes.Storage.GetCurrentTick();
+		VisitRows(InArchetype, InChunk, [&](std::size_t row) {
+			const EntityID& entity = InChunk.GetEntities()[row];
+			if constexpr (std::is_invocable_v<Func&, const EntityID&, Ts&...>)
+			{
+				InFunc(entity, static_cast<Ts&>(*columns[I][row])...);
+			}
+			else
+			{
+				InFunc(static_cast<Ts&>(*columns[I][row])...);
+			}
+
+			(MarkWritten<Ts>(InChunk, columnIds[I], row, tick), ...);
+		});
+	}
+};
+
+template<typename... Ts>
+ComponentQuery<Ts...> World::Query()
+{
+	return ComponentQuery<Ts...>(*this);
+}
+
+template<typename... Ts, typename Func>
+void World::Each(Func&& InFunc)
+{
+	Query<Ts...>().Each(std::forward<Func>(InFunc));
+}
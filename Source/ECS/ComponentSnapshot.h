@@ -0,0 +1,143 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Raw byte streams used by World snapshots, components write their state with BaseComponent::SaveSnapshot
+// and read it back in the same order with BaseComponent::LoadSnapshot.
+// State that isn't plain data (a material, say) is kept alive by the snapshot's object list and written as an index into it.
+class SnapshotWriter
+{
+public:
+	static constexpr std::uint32_t kNullObject = static_cast<std::uint32_t>(-1);
+
+	SnapshotWriter(std::vector<std::uint8_t>& InData, std::vector<std::shared_ptr<void>>* InObjects = nullptr)
+		: Data(InData)
+		, Objects(InObjects)
+	{
+	}
+
+	void WriteBytes(const void* InBytes, std::size_t InSize)
+	{
+		const std::size_t Offset = Data.size();
+		Data.resize(Offset + InSize);
+		if (InSize > 0)
+		{
+			std::memcpy(Data.data() + Offset, InBytes, InSize);
+		}
+	}
+
+	template<typename T>
+	void Write(const T& InValue)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written raw");
+		WriteBytes(&InValue, sizeof(T));
+	}
+
+	void Write(const std::string& InValue)
+	{
+		Write(static_cast<std::uint32_t>(InValue.size()));
+		WriteBytes(InValue.data(), InValue.size());
+	}
+
+	// InObject is shared, not copied. Hand over a private copy if the component keeps changing it.
+	template<typename T>
+	void WriteObject(const std::shared_ptr<T>& InObject)
+	{
+		assert(Objects && "This writer has no object list");
+		std::uint32_t Index = kNullObject;
+		if (InObject)
+		{
+			Index = static_cast<std::uint32_t>(Objects->size());
+			Objects->push_back(InObject);
+		}
+		Write(Index);
+	}
+
+private:
+	std::vector<std::uint8_t>& Data;
+	std::vector<std::shared_ptr<void>>* Objects;
+};
+
+class SnapshotReader
+{
+public:
+	SnapshotReader(const std::uint8_t* InData, std::size_t InSize, const std::vector<std::shared_ptr<void>>* InObjects = nullptr)
+		: Cursor(InData)
+		, End(InData + InSize)
+		, Objects(InObjects)
+	{
+	}
+
+	void ReadBytes(void* OutBytes, std::size_t InSize)
+	{
+		assert(Cursor + InSize <= End && "Reading past the end of a component snapshot");
+		if (InSize > 0)
+		{
+			std::memcpy(OutBytes, Cursor, InSize);
+		}
+		Cursor += InSize;
+	}
+
+	template<typename T>
+	void Read(T& OutValue)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read raw");
+		ReadBytes(&OutValue, sizeof(T));
+	}
+
+	void Read(std::string& OutValue)
+	{
+		std::uint32_t Size = 0;
+		Read(Size);
+		assert(Cursor + Size <= End && "Reading past the end of a component snapshot");
+		OutValue.assign(reinterpret_cast<const char*>(Cursor), Size);
+		Cursor += Size;
+	}
+
+	void Skip(std::size_t InSize)
+	{
+		assert(Cursor + InSize <= End && "Reading past the end of a component snapshot");
+		Cursor += InSize;
+	}
+
+	template<typename T>
+	T Read()
+	{
+		T Value;
+		Read(Value);
+		return Value;
+	}
+
+	// The object written by SnapshotWriter::WriteObject, still owned by the snapshot
+	template<typename T>
+	std::shared_ptr<T> ReadObject()
+	{
+		const std::uint32_t Index = Read<std::uint32_t>();
+		if (Index == SnapshotWriter::kNullObject)
+		{
+			return nullptr;
+		}
+		assert(Objects && Index < Objects->size() && "Snapshot object index out of range");
+		return std::static_pointer_cast<T>((*Objects)[Index]);
+	}
+
+	const std::uint8_t* GetCursor() const
+	{
+		return Cursor;
+	}
+
+	std::size_t GetRemaining() const
+	{
+		return static_cast<std::size_t>(End - Cursor);
+	}
+
+private:
+	const std::uint8_t* Cursor;
+	const std::uint8_t* End;
+	const std::vector<std::shared_ptr<void>>* Objects;
+};
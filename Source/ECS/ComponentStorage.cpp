@@ -4,7 +4,7 @@
 #include <iostream>
 
 ComponentStorage::ComponentStorage(std::size_t InEntityAmount) :
-	ComponentEntries(InEntityAmount)
+	EntityRecords(InEntityAmount)
 {
 }
 
@@ -14,14 +14,19 @@ ComponentStorage::~ComponentStorage()
 
 void ComponentStorage::AddComponent(Entity& InEntity, SharedPtr<BaseComponent> InComponent, TypeId InComponentTypeId)
 {
-	auto Index = InEntity.GetId().Index;
+	const EntityID& Id = InEntity.GetId();
+	EntityRecord& Record = EntityRecords[Id.Index];
 
-	auto& ComponentData = ComponentEntries[Index];
+	std::vector<SharedPtr<BaseComponent>> Dropped;
+	if (!Record.Owner || Record.Owner->GetColumn(InComponentTypeId) < 0)
+	{
+		MoveEntity(Id, GetArchetypeWith(Record.Owner, InComponentTypeId), Dropped);
+	}
 
-	CheckCapacity(ComponentData.Components, InComponentTypeId);
-	ComponentData.Components[InComponentTypeId] = InComponent;
+	const int Column = Record.Owner->GetColumn(InComponentTypeId);
+	Record.Owner->GetComponent(Record.Row, Column) = InComponent;
+	Record.Owner->MarkAdded(Record.Row, Column, CurrentTick);
 
-	ComponentData.ComponentTypeList[InComponentTypeId] = true;
 	//InEntity.SetActive(true);
 	if (!InEntity.IsLoading)
 	{
@@ -29,63 +34,264 @@ void ComponentStorage::AddComponent(Entity& InEntity, SharedPtr<BaseComponent> I
 	}
 }
 
+Archetype* ComponentStorage::AddEntities(const std::vector<EntityID>& InEntities, const ComponentTypeArray& InSignature, std::size_t& OutFirstRow)
+{
+	OutFirstRow = 0;
+	Archetype* Target = GetOrCreateArchetype(InSignature);
+	if (!Target || InEntities.empty())
+	{
+		return Target;
+	}
+
+	OutFirstRow = Target->GetCount();
+	for (const EntityID& Id : InEntities)
+	{
+		EntityRecord& Record = EntityRecords[Id.Index];
+		assert(!Record.Owner && "AddEntities expects entities without components");
+		Record.Owner = Target;
+		Record.Row = Target->Add(Id);
+		for (int Column = 0; Column < static_cast<int>(Target->GetTypes().size()); ++Column)
+		{
+			Target->MarkAdded(Record.Row, Column, CurrentTick);
+		}
+	}
+	return Target;
+}
+
 const ComponentTypeArray& ComponentStorage::GetComponentTypes(const Entity& InEntity) const
 {
-	return ComponentEntries[InEntity.GetId().Index].ComponentTypeList;
+	static const ComponentTypeArray EmptySignature;
+
+	const EntityRecord& Record = EntityRecords[InEntity.GetId().Index];
+	return Record.Owner ? Record.Owner->GetSignature() : EmptySignature;
 }
 
 void ComponentStorage::RemoveComponent(const Entity& InEntity, TypeId InTypeId)
 {
-	auto Index = InEntity.GetId().Index;
-	auto& ComponentData = ComponentEntries[Index];
+	const EntityID& Id = InEntity.GetId();
+	EntityRecord& Record = EntityRecords[Id.Index];
+
+	if (!Record.Owner || Record.Owner->GetColumn(InTypeId) < 0)
+	{
+		return;
+	}
 
-	ComponentData.Components[InTypeId].reset();
-	ComponentData.ComponentTypeList[InTypeId] = false;
+	// Keep the removed component alive until the entity has been moved, its destructor might touch the storage.
+	std::vector<SharedPtr<BaseComponent>> Dropped;
+	MoveEntity(Id, GetArchetypeWithout(Record.Owner, InTypeId), Dropped);
 }
 
 void ComponentStorage::RemoveAllComponents(Entity& InEntity)
 {
-	auto Index = InEntity.GetId().Index;
-	auto& ComponentData = ComponentEntries[Index];
+	const EntityID& Id = InEntity.GetId();
+	if (!EntityRecords[Id.Index].Owner)
+	{
+		return;
+	}
 
-	ComponentData.Components.clear();
-	ComponentData.ComponentTypeList.reset();
+	std::vector<SharedPtr<BaseComponent>> Dropped;
+	MoveEntity(Id, nullptr, Dropped);
 }
 
 std::vector<BaseComponent*> ComponentStorage::GetAllComponents(const Entity& InEntity)
 {
 	std::vector<BaseComponent*> components;
-	for (auto& i : ComponentEntries[InEntity.GetId().Index].Components)
+
+	const EntityRecord& Record = EntityRecords[InEntity.GetId().Index];
+	if (!Record.Owner)
 	{
-		if (i.get())
+		return components;
+	}
+
+	const std::size_t ColumnCount = Record.Owner->GetTypes().size();
+	components.reserve(ColumnCount);
+	for (std::size_t i = 0; i < ColumnCount; ++i)
+	{
+		BaseComponent* comp = Record.Owner->GetComponent(Record.Row, static_cast<int>(i)).get();
+		if (comp)
 		{
-			components.push_back(i.get());
+			components.push_back(comp);
 		}
 	}
 	return components;
 }
 
+const std::vector<UniquePtr<Archetype>>& ComponentStorage::GetArchetypes() const
+{
+	return Archetypes;
+}
+
+void ComponentStorage::SetCurrentTick(std::uint32_t InTick)
+{
+	CurrentTick = InTick;
+}
+
+std::uint32_t ComponentStorage::GetCurrentTick() const
+{
+	return CurrentTick;
+}
+
+void ComponentStorage::MarkChanged(const EntityID& InEntity, TypeId InTypeId)
+{
+	if (InEntity.Index >= EntityRecords.size())
+	{
+		return;
+	}
+
+	const EntityRecord& Record = EntityRecords[InEntity.Index];
+	const int Column = Record.Owner ? Record.Owner->GetColumn(InTypeId) : -1;
+	if (Column >= 0)
+	{
+		Record.Owner->MarkChanged(Record.Row, Column, CurrentTick);
+	}
+}
+
+void ComponentStorage::SetEntityState(const EntityID& InEntity, bool InIsActive, const CoreTypeArray& InCores)
+{
+	const EntityRecord& Record = EntityRecords[InEntity.Index];
+	if (Record.Owner)
+	{
+		Record.Owner->SetRowState(Record.Row, InIsActive, InCores);
+	}
+}
+
+const std::vector<ComponentStorage::RemovedComponent>& ComponentStorage::GetRemoved(TypeId InTypeId) const
+{
+	static const std::vector<RemovedComponent> Empty;
+	return InTypeId < Removed.size() ? Removed[InTypeId] : Empty;
+}
+
+void ComponentStorage::PruneRemoved(std::uint32_t InTick)
+{
+	for (std::vector<RemovedComponent>& List : Removed)
+	{
+		List.erase(std::remove_if(List.begin(), List.end(), [InTick](const RemovedComponent& InRemoved) {
+			return InRemoved.Tick <= InTick;
+		}), List.end());
+	}
+}
+
 void ComponentStorage::Resize(std::size_t InAmount)
 {
-	ComponentEntries.resize(InAmount);
+	EntityRecords.resize(InAmount);
 }
 
 void ComponentStorage::Reset()
 {
-	ComponentEntries.clear();
+	EntityRecords.clear();
+	ArchetypeLookup.clear();
+	Archetypes.clear();
+	Removed.clear();
 }
 
 BaseComponent& ComponentStorage::GetComponent(const Entity& InEntity, TypeId InTypeId)
 {
-	return *GetComponents_Implementation(InEntity)[InTypeId];
+	const EntityRecord& Record = EntityRecords[InEntity.GetId().Index];
+	return *Record.Owner->GetComponent(Record.Row, Record.Owner->GetColumn(InTypeId));
+}
+
+Archetype* ComponentStorage::GetOrCreateArchetype(const ComponentTypeArray& InSignature)
+{
+	if (InSignature.none())
+	{
+		return nullptr;
+	}
+
+	auto it = ArchetypeLookup.find(InSignature);
+	if (it != ArchetypeLookup.end())
+	{
+		return it->second;
+	}
+
+	Archetypes.push_back(MakeUnique<Archetype>(InSignature));
+	Archetype* NewArchetype = Archetypes.back().get();
+	ArchetypeLookup[InSignature] = NewArchetype;
+	return NewArchetype;
+}
+
+Archetype* ComponentStorage::GetArchetypeWith(Archetype* InSource, TypeId InTypeId)
+{
+	if (!InSource)
+	{
+		ComponentTypeArray Signature;
+		Signature[InTypeId] = true;
+		return GetOrCreateArchetype(Signature);
+	}
+
+	Archetype* Target = InSource->GetAddEdge(InTypeId);
+	if (!Target)
+	{
+		ComponentTypeArray Signature = InSource->GetSignature();
+		Signature[InTypeId] = true;
+		Target = GetOrCreateArchetype(Signature);
+		InSource->SetAddEdge(InTypeId, Target);
+	}
+	return Target;
 }
 
-ComponentStorage::ImplComponentArray& ComponentStorage::GetComponents_Implementation(const Entity& E)
+Archetype* ComponentStorage::GetArchetypeWithout(Archetype* InSource, TypeId InTypeId)
 {
-	return ComponentEntries[E.GetId().Index].Components;
+	Archetype* Target = InSource->GetRemoveEdge(InTypeId);
+	if (!Target)
+	{
+		ComponentTypeArray Signature = InSource->GetSignature();
+		Signature[InTypeId] = false;
+		Target = GetOrCreateArchetype(Signature);
+		if (Target)
+		{
+			InSource->SetRemoveEdge(InTypeId, Target);
+		}
+	}
+	return Target;
 }
 
-const ComponentStorage::ImplComponentArray& ComponentStorage::GetComponents_Implementation(const Entity& E) const
+void ComponentStorage::MoveEntity(const EntityID& InEntity, Archetype* InTarget, std::vector<SharedPtr<BaseComponent>>& OutDropped)
 {
-	return ComponentEntries[E.GetId().Index].Components;
-}
\ No newline at end of file
+	EntityRecord& Record = EntityRecords[InEntity.Index];
+	Archetype* Source = Record.Owner;
+
+	std::size_t NewRow = 0;
+	if (InTarget)
+	{
+		NewRow = InTarget->Add(InEntity);
+	}
+
+	if (Source)
+	{
+		const std::vector<TypeId>& SourceTypes = Source->GetTypes();
+		for (std::size_t i = 0; i < SourceTypes.size(); ++i)
+		{
+			SharedPtr<BaseComponent>& Comp = Source->GetComponent(Record.Row, static_cast<int>(i));
+			const int TargetColumn = InTarget ? InTarget->GetColumn(SourceTypes[i]) : -1;
+			if (TargetColumn >= 0)
+			{
+				InTarget->GetComponent(NewRow, TargetColumn) = std::move(Comp);
+				InTarget->MarkAdded(NewRow, TargetColumn, Source->GetAddedTick(Record.Row, static_cast<int>(i)));
+				InTarget->MarkChanged(NewRow, TargetColumn, Source->GetChangedTick(Record.Row, static_cast<int>(i)));
+			}
+			else
+			{
+				CheckCapacity(Removed, SourceTypes[i]);
+				Removed[SourceTypes[i]].push_back({ InEntity, CurrentTick });
+				if (Comp)
+				{
+					OutDropped.push_back(std::move(Comp));
+				}
+			}
+		}
+
+		if (InTarget)
+		{
+			InTarget->SetRowState(NewRow, Source->IsRowActive(Record.Row), Source->GetRowCores(Record.Row));
+		}
+
+		EntityID Moved = Source->Remove(Record.Row);
+		if (!Moved.IsNull())
+		{
+			EntityRecords[Moved.Index].Row = Record.Row;
+		}
+	}
+
+	Record.Owner = InTarget;
+	Record.Row = NewRow;
+}
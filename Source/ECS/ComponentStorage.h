@@ -1,10 +1,12 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 #include "ECS/Entity.h"
 #include "ECS/Component.h"
 #include "ECS/ComponentTypeArray.h"
+#include "ECS/Archetype.h"
 
 #include "Dementia.h"
 
@@ -19,6 +21,10 @@ public:
 
 	void AddComponent(Entity& InEntity, SharedPtr<BaseComponent> InComponent, TypeId InComponentTypeId);
 
+	// Place a block of component-less entities straight into the archetype for InSignature.
+	// Their rows are contiguous starting at OutFirstRow, the component slots are left empty for the caller to fill.
+	Archetype* AddEntities(const std::vector<EntityID>& InEntities, const ComponentTypeArray& InSignature, std::size_t& OutFirstRow);
+
 	BaseComponent& GetComponent(const Entity& InEntity, TypeId InTypeId);
 
 	const ComponentTypeArray& GetComponentTypes(const Entity& InEntity) const;
@@ -29,29 +35,80 @@ public:
 
 	std::vector<BaseComponent*> GetAllComponents(const Entity& InEntity);
 
+	// Calls InFunc(TypeId, BaseComponent&) for every component the entity owns, in TypeId order
+	template<typename Func>
+	void ForEachComponent(const Entity& InEntity, Func&& InFunc);
+
+	const std::vector<UniquePtr<Archetype>>& GetArchetypes() const;
+
+	// Change tracking, writes and adds are stamped with the current tick
+	struct RemovedComponent
+	{
+		EntityID Entity;
+		std::uint32_t Tick;
+	};
+
+	void SetCurrentTick(std::uint32_t InTick);
+	std::uint32_t GetCurrentTick() const;
+
+	void MarkChanged(const EntityID& InEntity, TypeId InTypeId);
+
+	// Copies the entity's active state and core membership into its row, entities without components are ignored.
+	// The state follows the row when the entity moves between archetypes.
+	void SetEntityState(const EntityID& InEntity, bool InIsActive, const CoreTypeArray& InCores);
+
+	// Components removed from entities (including destroyed ones), indexed by component TypeId
+	const std::vector<RemovedComponent>& GetRemoved(TypeId InTypeId) const;
+
+	// Forget removals stamped at or before InTick
+	void PruneRemoved(std::uint32_t InTick);
+
 	void Resize(std::size_t InAmount);
 
 	void Reset();
 private:
-	typedef std::vector<std::shared_ptr<BaseComponent>> ImplComponentArray;
-
-	struct EntityComponents
+	struct EntityRecord
 	{
-		EntityComponents() = default;
+		// nullptr while the entity doesn't own any components
+		Archetype* Owner = nullptr;
+		std::size_t Row = 0;
+	};
 
-		EntityComponents(EntityComponents&& E) :
-			Components(std::move(E.Components)),
-			ComponentTypeList(std::move(E.ComponentTypeList))
-		{
-		}
-		ImplComponentArray Components;
+	std::vector<EntityRecord> EntityRecords;
 
-		ComponentTypeArray ComponentTypeList;
-	};
+	std::vector<UniquePtr<Archetype>> Archetypes;
+
+	std::unordered_map<ComponentTypeArray, Archetype*> ArchetypeLookup;
+
+	std::uint32_t CurrentTick = 0;
 
-	std::vector<EntityComponents> ComponentEntries;
+	std::vector<std::vector<RemovedComponent>> Removed;
 
-	inline ImplComponentArray& GetComponents_Implementation(const Entity& E);
+	Archetype* GetOrCreateArchetype(const ComponentTypeArray& InSignature);
 
-	inline const ImplComponentArray& GetComponents_Implementation(const Entity& E) const;
+	Archetype* GetArchetypeWith(Archetype* InSource, TypeId InTypeId);
+
+	Archetype* GetArchetypeWithout(Archetype* InSource, TypeId InTypeId);
+
+	// Moves every component the entity owns over to InTarget, components the target doesn't store are handed back in OutDropped.
+	void MoveEntity(const EntityID& InEntity, Archetype* InTarget, std::vector<SharedPtr<BaseComponent>>& OutDropped);
 };
+
+template<typename Func>
+void ComponentStorage::ForEachComponent(const Entity& InEntity, Func&& InFunc)
+{
+	const EntityRecord& Record = EntityRecords[InEntity.GetId().Index];
+	if (!Record.Owner)
+	{
+		return;
+	}
+
+	const std::vector<TypeId>& Types = Record.Owner->GetTypes();
+	for (std::size_t i = 0; i < Types.size(); ++i)
+	{
+		if (BaseComponent* Comp = Record.Owner->GetComponent(Record.Row, static_cast<int>(i)).get())
+		{
+			InFunc(Types[i], *Comp);
+		}
+	}
+}
@@ -1,9 +1,302 @@
 // 2018 Mitchell Andrews
 
 #pragma once
-#include <bitset>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <assert.h>
 
-typedef std::bitset<64> ComponentTypeArray;
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define ME_SIGNATURE_SSE 1
+#include <emmintrin.h>
+#else
+#define ME_SIGNATURE_SSE 0
+#endif
+
+// Upper bound of component / core types in a project, override with a build define (multiples of 128).
+#ifndef ME_MAX_COMPONENT_TYPES
+#define ME_MAX_COMPONENT_TYPES 128
+#endif
+
+#ifndef ME_MAX_CORE_TYPES
+#define ME_MAX_CORE_TYPES 128
+#endif
+
+// Fixed width bit set used for component signatures and core membership.
+// Laid out as 128 bit lanes so the filter tests below compile to a handful of SSE instructions.
+template<std::size_t Bits>
+class TypeSignature
+{
+	static_assert(Bits > 0 && Bits % 128 == 0, "Signature width must be a multiple of 128 bits");
+
+public:
+	static constexpr std::size_t kWordCount = Bits / 64;
+
+	class Reference
+	{
+	public:
+		Reference(std::uint64_t& InWord, std::uint64_t InMask)
+			: Word(InWord)
+			, Mask(InMask)
+		{
+		}
+
+		operator bool() const
+		{
+			return (Word & Mask) != 0;
+		}
+
+		Reference& operator=(bool InValue)
+		{
+			Word = InValue ? (Word | Mask) : (Word & ~Mask);
+			return *this;
+		}
+
+	private:
+		std::uint64_t& Word;
+		std::uint64_t Mask;
+	};
+
+	TypeSignature()
+	{
+		reset();
+	}
+
+	constexpr std::size_t size() const
+	{
+		return Bits;
+	}
+
+	bool operator[](std::size_t InIndex) const
+	{
+		assert(InIndex < Bits && "Type index is out of range, raise the signature width define");
+		return (Words[InIndex / 64] & (std::uint64_t(1) << (InIndex % 64))) != 0;
+	}
+
+	Reference operator[](std::size_t InIndex)
+	{
+		assert(InIndex < Bits && "Type index is out of range, raise the signature width define");
+		return Reference(Words[InIndex / 64], std::uint64_t(1) << (InIndex % 64));
+	}
+
+	bool test(std::size_t InIndex) const
+	{
+		return (*this)[InIndex];
+	}
+
+	void set(std::size_t InIndex, bool InValue = true)
+	{
+		(*this)[InIndex] = InValue;
+	}
+
+	void reset()
+	{
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			Words[i] = 0;
+		}
+	}
+
+	bool any() const
+	{
+#if ME_SIGNATURE_SSE
+		__m128i acc = _mm_setzero_si128();
+		for (std::size_t i = 0; i < kWordCount; i += 2)
+		{
+			acc = _mm_or_si128(acc, Load(i));
+		}
+		return !IsZero(acc);
+#else
+		std::uint64_t acc = 0;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			acc |= Words[i];
+		}
+		return acc != 0;
+#endif
+	}
+
+	bool none() const
+	{
+		return !any();
+	}
+
+	// (this & InOther) == InOther
+	bool ContainsAll(const TypeSignature& InOther) const
+	{
+#if ME_SIGNATURE_SSE
+		__m128i acc = _mm_setzero_si128();
+		for (std::size_t i = 0; i < kWordCount; i += 2)
+		{
+			const __m128i other = InOther.Load(i);
+			acc = _mm_or_si128(acc, _mm_andnot_si128(Load(i), other));
+		}
+		return IsZero(acc);
+#else
+		std::uint64_t acc = 0;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			acc |= InOther.Words[i] & ~Words[i];
+		}
+		return acc == 0;
+#endif
+	}
+
+	// (this & InOther).any()
+	bool Intersects(const TypeSignature& InOther) const
+	{
+#if ME_SIGNATURE_SSE
+		__m128i acc = _mm_setzero_si128();
+		for (std::size_t i = 0; i < kWordCount; i += 2)
+		{
+			acc = _mm_or_si128(acc, _mm_and_si128(Load(i), InOther.Load(i)));
+		}
+		return !IsZero(acc);
+#else
+		std::uint64_t acc = 0;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			acc |= Words[i] & InOther.Words[i];
+		}
+		return acc != 0;
+#endif
+	}
+
+	// ContainsAll(InAll), Intersects(InAny) and Intersects(InNone) in one pass, each lane of this signature is loaded once
+	void Match(const TypeSignature& InAll, const TypeSignature& InAny, const TypeSignature& InNone, bool& OutContainsAll, bool& OutIntersectsAny, bool& OutIntersectsNone) const
+	{
+#if ME_SIGNATURE_SSE
+		__m128i missing = _mm_setzero_si128();
+		__m128i any = _mm_setzero_si128();
+		__m128i none = _mm_setzero_si128();
+		for (std::size_t i = 0; i < kWordCount; i += 2)
+		{
+			const __m128i lane = Load(i);
+			missing = _mm_or_si128(missing, _mm_andnot_si128(lane, InAll.Load(i)));
+			any = _mm_or_si128(any, _mm_and_si128(lane, InAny.Load(i)));
+			none = _mm_or_si128(none, _mm_and_si128(lane, InNone.Load(i)));
+		}
+		OutContainsAll = IsZero(missing);
+		OutIntersectsAny = !IsZero(any);
+		OutIntersectsNone = !IsZero(none);
+#else
+		std::uint64_t missing = 0;
+		std::uint64_t any = 0;
+		std::uint64_t none = 0;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			missing |= InAll.Words[i] & ~Words[i];
+			any |= Words[i] & InAny.Words[i];
+			none |= Words[i] & InNone.Words[i];
+		}
+		OutContainsAll = missing == 0;
+		OutIntersectsAny = any != 0;
+		OutIntersectsNone = none != 0;
+#endif
+	}
+
+	TypeSignature operator&(const TypeSignature& InOther) const
+	{
+		TypeSignature result;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			result.Words[i] = Words[i] & InOther.Words[i];
+		}
+		return result;
+	}
+
+	TypeSignature operator|(const TypeSignature& InOther) const
+	{
+		TypeSignature result;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			result.Words[i] = Words[i] | InOther.Words[i];
+		}
+		return result;
+	}
+
+	TypeSignature operator~() const
+	{
+		TypeSignature result;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			result.Words[i] = ~Words[i];
+		}
+		return result;
+	}
+
+	bool operator==(const TypeSignature& InOther) const
+	{
+#if ME_SIGNATURE_SSE
+		__m128i acc = _mm_setzero_si128();
+		for (std::size_t i = 0; i < kWordCount; i += 2)
+		{
+			acc = _mm_or_si128(acc, _mm_xor_si128(Load(i), InOther.Load(i)));
+		}
+		return IsZero(acc);
+#else
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			if (Words[i] != InOther.Words[i])
+			{
+				return false;
+			}
+		}
+		return true;
+#endif
+	}
+
+	bool operator!=(const TypeSignature& InOther) const
+	{
+		return !operator==(InOther);
+	}
+
+	std::size_t Hash() const
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for (std::size_t i = 0; i < kWordCount; ++i)
+		{
+			hash = (hash ^ Words[i]) * 1099511628211ull;
+		}
+		return static_cast<std::size_t>(hash ^ (hash >> 32));
+	}
+
+	const std::uint64_t* GetWords() const
+	{
+		return Words;
+	}
+
+private:
+	alignas(16) std::uint64_t Words[kWordCount];
+
+#if ME_SIGNATURE_SSE
+	inline __m128i Load(std::size_t InWord) const
+	{
+		return _mm_load_si128(reinterpret_cast<const __m128i*>(Words + InWord));
+	}
+
+	static inline bool IsZero(__m128i InValue)
+	{
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(InValue, _mm_setzero_si128())) == 0xFFFF;
+	}
+#endif
+};
+
+namespace std
+{
+	template<std::size_t Bits>
+	struct hash<TypeSignature<Bits>>
+	{
+		std::size_t operator()(const TypeSignature<Bits>& InSignature) const
+		{
+			return InSignature.Hash();
+		}
+	};
+}
+
+typedef TypeSignature<ME_MAX_COMPONENT_TYPES> ComponentTypeArray;
+
+typedef TypeSignature<ME_MAX_CORE_TYPES> CoreTypeArray;
 
 template <class TContainer>
 void CheckCapacity(TContainer& InContainer, typename TContainer::size_type InIndex)
@@ -12,4 +305,4 @@ void CheckCapacity(TContainer& InContainer, typename TContainer::size_type InInd
 	{
 		InContainer.resize(InIndex + 1);
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #include "PCH.h"
 #include "Core.h"
+#if ME_EDITOR
 #include <imgui.h>
+#endif
+#include <algorithm>
 #include <string>
 
 BaseCore::BaseCore(const char* CompName, const ComponentFilter& Filter)
@@ -30,6 +33,11 @@ const ComponentFilter& BaseCore::GetComponentFilter() const
 	return CompFilter;
 }
 
+std::uint32_t BaseCore::GetLastUpdateTick() const
+{
+	return LastUpdateTick;
+}
+
 const std::string& BaseCore::GetName() const
 {
 	return Name;
@@ -37,19 +45,137 @@ const std::string& BaseCore::GetName() const
 
 void BaseCore::Add(Entity& InEntity)
 {
-	Entities.push_back(InEntity);
-	OnEntityAdded(InEntity);
+	if (InsertEntity(InEntity))
+	{
+		OnEntityAdded(InEntity);
+	}
 }
 
 void BaseCore::Remove(Entity& InEntity)
 {
+	if (!HasEntity(InEntity))
+	{
+		return;
+	}
+
 	OnEntityRemoved(InEntity);
-	Entities.erase(std::remove(Entities.begin(), Entities.end(), InEntity), Entities.end());
+	EraseEntity(InEntity);
+	if (PreserveEntityOrder)
+	{
+		CompactEntities();
+	}
+}
+
+void BaseCore::AddEntities(std::vector<Entity>& InEntities)
+{
+	Entities.reserve(Entities.size() + InEntities.size());
+	// Like Add, entities that are already registered don't get a second callback
+	InEntities.erase(std::remove_if(InEntities.begin(), InEntities.end(), [this](const Entity& InEntity) {
+		return !InsertEntity(InEntity);
+	}), InEntities.end());
+	if (!InEntities.empty())
+	{
+		OnEntitiesAdded(InEntities);
+	}
+}
+
+void BaseCore::RemoveEntities(std::vector<Entity>& InEntities)
+{
+	InEntities.erase(std::remove_if(InEntities.begin(), InEntities.end(), [this](const Entity& InEntity) {
+		return !HasEntity(InEntity);
+	}), InEntities.end());
+	if (InEntities.empty())
+	{
+		return;
+	}
+
+	OnEntitiesRemoved(InEntities);
+	for (Entity& InEntity : InEntities)
+	{
+		EraseEntity(InEntity);
+	}
+	if (PreserveEntityOrder)
+	{
+		CompactEntities();
+	}
+}
+
+bool BaseCore::HasEntity(const Entity& InEntity) const
+{
+	const auto Index = InEntity.GetId().Index;
+	return Index < EntitySlots.size() && EntitySlots[Index] < Entities.size() && Entities[EntitySlots[Index]] == InEntity;
+}
+
+bool BaseCore::InsertEntity(const Entity& InEntity)
+{
+	if (HasEntity(InEntity))
+	{
+		return false;
+	}
+
+	if (EntitySlots.size() <= InEntity.GetId().Index)
+	{
+		EntitySlots.resize(InEntity.GetId().Index + 1, kInvalidSlot);
+	}
+	EntitySlots[InEntity.GetId().Index] = Entities.size();
+	Entities.push_back(InEntity);
+	return true;
+}
+
+void BaseCore::EraseEntity(const Entity& InEntity)
+{
+	if (!HasEntity(InEntity))
+	{
+		return;
+	}
+
+	std::size_t& Slot = EntitySlots[InEntity.GetId().Index];
+	if (PreserveEntityOrder)
+	{
+		// Leave a hole that CompactEntities closes once the whole batch has been removed
+		Entities[Slot] = Entity();
+	}
+	else
+	{
+		if (Slot != Entities.size() - 1)
+		{
+			Entities[Slot] = Entities.back();
+			EntitySlots[Entities[Slot].GetId().Index] = Slot;
+		}
+		Entities.pop_back();
+	}
+	Slot = kInvalidSlot;
+}
+
+void BaseCore::CompactEntities()
+{
+	Entities.erase(std::remove_if(Entities.begin(), Entities.end(), [](const Entity& InEntity) { return !InEntity; }), Entities.end());
+	for (std::size_t i = 0; i < Entities.size(); ++i)
+	{
+		EntitySlots[Entities[i].GetId().Index] = i;
+	}
+}
+
+void BaseCore::OnEntitiesAdded(std::vector<Entity>& NewEntities)
+{
+	for (Entity& NewEntity : NewEntities)
+	{
+		OnEntityAdded(NewEntity);
+	}
+}
+
+void BaseCore::OnEntitiesRemoved(std::vector<Entity>& InEntities)
+{
+	for (Entity& InEntity : InEntities)
+	{
+		OnEntityRemoved(InEntity);
+	}
 }
 
 void BaseCore::Clear()
 {
 	Entities.clear();
+	EntitySlots.clear();
 }
 
 const bool BaseCore::GetIsSerializable() const
@@ -62,6 +188,11 @@ void BaseCore::SetIsSerializable(bool value)
 	IsSerializable = value;
 }
 
+void BaseCore::SetPreserveEntityOrder(bool value)
+{
+	PreserveEntityOrder = value;
+}
+
 #if ME_EDITOR
 
 void BaseCore::OnEditorInspect()
@@ -40,6 +40,10 @@ public:
 	virtual void LateUpdate(const UpdateContext& inUpdateContext) {};
 	virtual void OnEntityAdded(Entity& NewEntity) {};
 	virtual void OnEntityRemoved(Entity& InEntity) {};
+
+	// Batched versions of the callbacks above, by default they forward to OnEntityAdded / OnEntityRemoved
+	virtual void OnEntitiesAdded(std::vector<Entity>& NewEntities);
+	virtual void OnEntitiesRemoved(std::vector<Entity>& InEntities);
 	virtual void OnEntityDestroyed(Entity& InEntity) {};
 	virtual void OnDrawGuizmo(DebugDrawer*) {};
 
@@ -47,6 +51,8 @@ public:
 	World& GetWorld() const;
 
 	// Get All the entities that are within the Core
+	// Membership only changes inside of World::Simulate so the array is stable for the rest of the frame.
+	// Removals swap the last entity into the hole unless SetPreserveEntityOrder(true) was called.
 	const std::vector<Entity>& GetEntities() const;
 
 	// Get All the entities that are within the Core
@@ -57,6 +63,10 @@ public:
 
 	const std::string& GetName() const;
 
+	// World change tick of this core's previous Update, pass it to ComponentQuery::Changed/Added
+	// to only process what changed since then. 0 before the first update.
+	std::uint32_t GetLastUpdateTick() const;
+
 #if ME_EDITOR
 	virtual void OnEditorInspect();
 	virtual void Serialize(json& outJson) = 0;
@@ -67,6 +77,9 @@ public:
 protected:
 	void SetIsSerializable(bool value);
 
+	// Keep entities in insertion order when removing, this costs a compaction pass per removal batch.
+	void SetPreserveEntityOrder(bool value);
+
 	class Engine* GameEngine;
 	World* GameWorld;
 
@@ -83,11 +96,26 @@ private:
 
 	void Remove(Entity& InEntity);
 
+	// Batch Add / Remove, InEntities is trimmed to the entities that actually joined or left the core
+	void AddEntities(std::vector<Entity>& InEntities);
+
+	void RemoveEntities(std::vector<Entity>& InEntities);
+
 	void Clear();
 
+	bool HasEntity(const Entity& InEntity) const;
+	bool InsertEntity(const Entity& InEntity);
+	void EraseEntity(const Entity& InEntity);
+	void CompactEntities();
+
 	// The Entities that are attached to this system
 	std::vector<Entity> Entities;
 
+	static constexpr std::size_t kInvalidSlot = static_cast<std::size_t>(-1);
+
+	// Position of each entity inside of Entities, indexed by EntityID::Index
+	std::vector<std::size_t> EntitySlots;
+
 	// The World attached to the system
 
 	ComponentFilter CompFilter;
@@ -97,7 +125,8 @@ private:
 	bool IsRunning = false;
 	bool DestroyOnLoad = true;
 	bool IsSerializable = true;
-	bool _padding[5];
+	bool PreserveEntityOrder = false;
+	std::uint32_t LastUpdateTick = 0;
 };
 
 // Use the CRTP patten to define custom systems
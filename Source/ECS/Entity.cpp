@@ -6,8 +6,8 @@
 
 #if ME_EDITOR
 #include "imgui.h"
-#endif
 #include "Utils/HavanaUtils.h"
+#endif
 
 Entity::Entity()
 {
@@ -25,15 +25,18 @@ Entity::~Entity()
 
 const bool Entity::HasComponent(TypeId inComponentType) const
 {
-	ComponentTypeArray ar = GameWorld->EntityAttributes.Storage.GetComponentTypes(*this);
+	const ComponentTypeArray& ar = GameWorld->EntityAttributes.Storage.GetComponentTypes(*this);
 
 	return ar[inComponentType] == true;
 }
 
 void Entity::AddComponent(SharedPtr<BaseComponent> inComponent, TypeId inComponentTypeId)
 {
-	inComponent->Parent = EntityHandle(GetId(), GameWorld->GetSharedPtr());
+	GameWorld->AssertNoParallelWave();
+	inComponent->Parent = EntityHandle(GetId(), GameWorld);
 	GameWorld->EntityAttributes.Storage.AddComponent(*this, inComponent, inComponentTypeId);
+	// The first component gives the entity a row, which starts out inactive
+	GameWorld->SyncEntityState(GetId());
 	if(!IsLoading)
 	SetActive(true);
 }
@@ -88,6 +91,7 @@ bool Entity::operator==(const Entity& entity) const
 
 void Entity::RemoveComponent(TypeId InComponentTypeId)
 {
+	GameWorld->AssertNoParallelWave();
 	GameWorld->EntityAttributes.Storage.RemoveComponent(*this, InComponentTypeId);
 }
 
@@ -100,7 +100,7 @@ T& Entity::AddComponent(Args&&... args)
 	{
 		return GetComponent<T>();
 	}
-	SharedPtr<T> t = MakeShared<T>(std::forward<Args>(args)...);
+	SharedPtr<T> t = MakeComponent<T>(std::forward<Args>(args)...);
 	return AddComponent(t);
 }
 
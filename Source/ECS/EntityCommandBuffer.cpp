@@ -0,0 +1,45 @@
+#include "PCH.h"
+#include "EntityCommandBuffer.h"
+
+void EntityCommandBuffer::SetSortKey(std::uint32_t InSortKey)
+{
+	CurrentSortKey = InSortKey;
+}
+
+EntityCommandBuffer::DeferredEntity EntityCommandBuffer::CreateEntity()
+{
+	DeferredEntity entity;
+	entity.Index = static_cast<int>(CreatedEntities.size());
+	CreatedEntities.emplace_back();
+	Record(CommandType::Create, entity);
+	return entity;
+}
+
+void EntityCommandBuffer::DestroyEntity(const Target& InEntity)
+{
+	Record(CommandType::Destroy, InEntity);
+}
+
+void EntityCommandBuffer::SetActive(const Target& InEntity, bool InActive)
+{
+	Record(CommandType::SetActive, InEntity).Active = InActive;
+}
+
+bool EntityCommandBuffer::IsEmpty() const
+{
+	return Commands.empty();
+}
+
+void EntityCommandBuffer::Clear()
+{
+	Commands.clear();
+	CreatedEntities.clear();
+	CurrentSortKey = 0;
+}
+
+EntityCommandBuffer::Command& EntityCommandBuffer::Record(CommandType InType, const Target& InEntity)
+{
+	Command& cmd = Commands.emplace_back(InType, InEntity);
+	cmd.SortKey = CurrentSortKey;
+	return cmd;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "ClassTypeId.h"
+#include "ECS/Component.h"
+#include "ECS/EntityID.h"
+#include "Pointers.h"
+
+// Records structural changes (create, add/remove component, destroy, set active) so jobs can request them
+// without touching the world. Every job engine worker records into its own buffer, no locking is involved.
+// The world plays all buffers back at the start of World::Simulate, ordered by sort key and then by recording order.
+// Give every job its own sort key (a chunk or batch index works) to keep playback deterministic across runs.
+class EntityCommandBuffer
+{
+	friend class World;
+public:
+	// An entity that will be created during playback, only valid with the buffer that created it.
+	struct DeferredEntity
+	{
+		int Index = -1;
+	};
+
+	// Either an existing entity or one created earlier in this buffer.
+	struct Target
+	{
+		Target(const EntityID& InEntity)
+			: Entity(InEntity)
+		{
+		}
+
+		Target(const DeferredEntity& InEntity)
+			: Deferred(InEntity.Index)
+		{
+		}
+
+		EntityID Entity;
+		int Deferred = -1;
+	};
+
+	EntityCommandBuffer() = default;
+
+	void SetSortKey(std::uint32_t InSortKey);
+
+	DeferredEntity CreateEntity();
+
+	template<typename T, typename... Args>
+	void AddComponent(const Target& InEntity, Args&&... args);
+
+	template<typename T>
+	void RemoveComponent(const Target& InEntity);
+
+	void DestroyEntity(const Target& InEntity);
+
+	void SetActive(const Target& InEntity, bool InActive);
+
+	bool IsEmpty() const;
+
+	void Clear();
+
+private:
+	enum class CommandType : std::uint8_t
+	{
+		Create = 0,
+		AddComponent,
+		RemoveComponent,
+		Destroy,
+		SetActive
+	};
+
+	struct Command
+	{
+		CommandType Type;
+		bool Active = false;
+		std::uint32_t SortKey = 0;
+		Target Entity;
+		TypeId ComponentType = 0;
+		SharedPtr<BaseComponent> Component;
+
+		Command(CommandType InType, const Target& InEntity)
+			: Type(InType)
+			, Entity(InEntity)
+		{
+		}
+	};
+
+	std::vector<Command> Commands;
+
+	// Filled in during playback, indexed by DeferredEntity::Index
+	std::vector<EntityID> CreatedEntities;
+
+	std::uint32_t CurrentSortKey = 0;
+
+	Command& Record(CommandType InType, const Target& InEntity);
+};
+
+template<typename T, typename... Args>
+void EntityCommandBuffer::AddComponent(const Target& InEntity, Args&&... args)
+{
+	static_assert(std::is_base_of<BaseComponent, T>(), "T is not a component, cannot add T to entity");
+	Command& cmd = Record(CommandType::AddComponent, InEntity);
+	cmd.ComponentType = T::GetTypeId();
+	cmd.Component = MakeComponent<T>(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void EntityCommandBuffer::RemoveComponent(const Target& InEntity)
+{
+	Record(CommandType::RemoveComponent, InEntity).ComponentType = T::GetTypeId();
+}
@@ -3,7 +3,7 @@
 #include "Entity.h"
 #include "Engine/World.h"
 
-EntityHandle::EntityHandle(EntityID InID, WeakPtr<World> InWorld)
+EntityHandle::EntityHandle(EntityID InID, World* InWorld)
 	: ID(InID)
 	, GameWorld(InWorld)
 {
@@ -12,7 +12,7 @@ EntityHandle::EntityHandle(EntityID InID, WeakPtr<World> InWorld)
 
 EntityHandle::operator bool() const
 {
-	return GameWorld.lock() && GameWorld.lock()->EntityExists(ID);
+	return GameWorld && GameWorld->EntityExists(ID);
 }
 
 bool EntityHandle::operator==(const EntityHandle& other) const
@@ -27,5 +27,15 @@ Entity* EntityHandle::operator->() const
 
 Entity* EntityHandle::Get() const
 {
-	return GameWorld.lock() ? GameWorld.lock()->GetEntityRaw(ID) : nullptr;
+	return GameWorld ? GameWorld->GetEntityRaw(ID) : nullptr;
+}
+
+const EntityID& EntityHandle::GetId() const
+{
+	return ID;
+}
+
+World* EntityHandle::GetWorld() const
+{
+	return GameWorld;
 }
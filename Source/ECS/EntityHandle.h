@@ -14,11 +14,13 @@ struct EntityIDHash
 	}
 };
 
+// Resolving a handle is an index into the world's entity registry plus a generation compare.
+// The world is held by raw pointer, handles must not outlive the world that created them.
 class EntityHandle
 {
 public:
 	EntityHandle() = default;
-	EntityHandle(EntityID InID, WeakPtr<World> InWorld);
+	EntityHandle(EntityID InID, World* InWorld);
 
 	explicit operator bool() const;
 	bool operator ==(const EntityHandle& other) const;
@@ -26,7 +28,10 @@ public:
 
 	Entity* Get() const;
 
+	const EntityID& GetId() const;
+	World* GetWorld() const;
+
 private:
 	EntityID ID;
-	WeakPtr<World> GameWorld;
+	World* GameWorld = nullptr;
 };
@@ -27,7 +27,7 @@ struct EntityID
 
 	inline IntType Value() const
 	{
-		return (Counter << MITCH_ENTITY_ID_COUNTER_BIT_COUNT) | Index;
+		return (Counter << MITCH_ENTITY_ID_INDEX_BIT_COUNT) | Index;
 	}
 
 	void Clear()
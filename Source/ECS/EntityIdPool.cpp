@@ -25,6 +25,22 @@ EntityID EntityIdPool::Create()
 	return Id;
 }
 
+void EntityIdPool::Create(std::size_t InCount, std::vector<EntityID>& OutIds)
+{
+	OutIds.reserve(OutIds.size() + InCount);
+
+	const std::size_t Reused = std::min(InCount, FreeList.size());
+	OutIds.insert(OutIds.end(), FreeList.end() - Reused, FreeList.end());
+	FreeList.resize(FreeList.size() - Reused);
+
+	for (std::size_t i = Reused; i < InCount; ++i)
+	{
+		EntityID Id(NextId++, 1);
+		Entities[Id.Index] = Id.Counter;
+		OutIds.push_back(Id);
+	}
+}
+
 std::size_t EntityIdPool::GetSize() const
 {
 	return Entities.size();
@@ -47,4 +63,22 @@ void EntityIdPool::Remove(EntityID InEntityId)
 	auto& Counter = Entities[InEntityId.Index];
 	++Counter;
 	FreeList.emplace_back(InEntityId.Index, Counter);
-}
\ No newline at end of file
+}
+
+void EntityIdPool::CopyState(std::size_t& OutNextId, std::vector<EntityID>& OutFreeList, std::vector<EntityID::IntType>& OutCounters) const
+{
+	OutNextId = NextId;
+	OutFreeList = FreeList;
+	OutCounters.assign(Entities.begin(), Entities.begin() + std::min(NextId, Entities.size()));
+}
+
+void EntityIdPool::RestoreState(std::size_t InNextId, const std::vector<EntityID>& InFreeList, const std::vector<EntityID::IntType>& InCounters)
+{
+	NextId = InNextId;
+	FreeList = InFreeList;
+	if (Entities.size() < InCounters.size())
+	{
+		Entities.resize(InCounters.size());
+	}
+	std::copy(InCounters.begin(), InCounters.end(), Entities.begin());
+}
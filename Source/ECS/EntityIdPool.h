@@ -13,12 +13,19 @@ public:
 
 	EntityID Create();
 
+	// Hands out InCount ids, recycled ids first and then one contiguous block of fresh indices.
+	void Create(std::size_t InCount, std::vector<EntityID>& OutIds);
+
 	std::size_t GetSize() const;
 
 	void Resize(std::size_t InAmount);
 	void Reset();
 
 	void Remove(EntityID InEntityId);
+
+	// Used by World snapshots to bring the pool back to an earlier state
+	void CopyState(std::size_t& OutNextId, std::vector<EntityID>& OutFreeList, std::vector<EntityID::IntType>& OutCounters) const;
+	void RestoreState(std::size_t InNextId, const std::vector<EntityID>& InFreeList, const std::vector<EntityID::IntType>& InCounters);
 protected:
 private:
 	std::size_t DefaultPoolSize;
@@ -44,7 +44,6 @@ Engine& GetEngine()
 
 Engine::Engine()
 	: Running(true)
-	, newJobSystem(1, 100000)
 {
 	std::vector<TypeId> events;
 	events.push_back(LoadSceneEvent::GetEventId());
@@ -151,7 +150,10 @@ void Engine::Init(Game* game)
 	//m_renderer = new Moonlight::Renderer();
 	//m_renderer->WindowResized(GameWindow->GetSize());
 
+	newJobSystem = MakeUnique<JobEngine>(engineConfig ? engineConfig->JobSettings : JobEngineSettings());
+
 	GameWorld = MakeShared<World>();
+	GameWorld->SetJobEngine(newJobSystem.get());
 
 	Cameras = new CameraCore();
 
@@ -185,6 +187,9 @@ void Engine::InitGame()
 	GameWorld->AddCore<AudioCore>(*AudioThread);
 	GameWorld->AddCore<UICore>(*UI);
 
+	// Scene nodes and audio don't share components and update side by side, the renderer needs the new world matrices
+	GameWorld->SetEngineCores({ SceneNodes, AudioThread, ModelRenderer });
+
 	m_game->OnInitialize();
 }
 
@@ -269,13 +274,6 @@ void Engine::Run()
 				FrameProfile::GetInstance().Complete("Physics");
 			}
 
-			// Update Cameras
-			{
-				FrameProfile::GetInstance().Set("SceneNodes", ProfileCategory::UI);
-				SceneNodes->Update(updateContext);
-				FrameProfile::GetInstance().Complete("SceneNodes");
-			}
-
 			// Update Game Application
 			{
 				FrameProfile::GetInstance().Set("Game", ProfileCategory::Game);
@@ -285,17 +283,11 @@ void Engine::Run()
 				FrameProfile::GetInstance().Complete("Game");
 			}
 
-			// Update Audio
-			{
-
-				AudioThread->Update(deltaTime);
-			}
-
-			// Model Renderer Update
+			// Scene nodes, audio and the model renderer, after gameplay has moved things and before anything is sent to the renderer
 			{
-				FrameProfile::GetInstance().Set("ModelRenderer", ProfileCategory::Rendering);
-				ModelRenderer->Update(updateContext);
-				FrameProfile::GetInstance().Complete("ModelRenderer");
+				FrameProfile::GetInstance().Set("EngineCores", ProfileCategory::Rendering);
+				GameWorld->UpdateEngineCores(updateContext);
+				FrameProfile::GetInstance().Complete("EngineCores");
 			}
             
 			// UI Update
@@ -309,7 +301,7 @@ void Engine::Run()
 					{
 						UI->OnResize(Camera::CurrentCamera->OutputSize);
 					}
-					UI->Update(updateContext);
+					GameWorld->UpdateUnscheduledCore(*UI, updateContext);
 				}
 				FrameProfile::GetInstance().Complete("UI");
 			}
@@ -317,7 +309,7 @@ void Engine::Run()
 			// Late Update	
 			{
 				GameWorld->LateUpdateLoadedCores(updateContext);
-				Cameras->Update(updateContext);
+				GameWorld->UpdateUnscheduledCore(*Cameras, updateContext);
 				SceneNodes->LateUpdate(updateContext);
 				Cameras->LateUpdate(updateContext);
 				AudioThread->LateUpdate(updateContext);
@@ -425,12 +417,12 @@ Input& Engine::GetInput()
 
 JobEngine& Engine::GetJobEngine()
 {
-	return newJobSystem;
+	return *newJobSystem;
 }
 
 std::tuple<Worker*, Pool&> Engine::GetJobSystemNew()
 {
-	return { newJobSystem.GetThreadWorker(), newJobSystem.GetThreadWorker()->GetPool() };
+	return { newJobSystem->GetThreadWorker(), newJobSystem->GetThreadWorker()->GetPool() };
 }
 
 void Engine::LoadScene(const std::string& SceneFile)
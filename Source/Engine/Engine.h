@@ -86,7 +86,8 @@ private:
 
 	BGFXRenderer* NewRenderer = nullptr;
 
-	JobEngine newJobSystem;
+	// Created in Init on the main thread, it becomes the foreground worker
+	UniquePtr<JobEngine> newJobSystem;
 
 	EngineUpdateContext updateContext;
 
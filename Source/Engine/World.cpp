@@ -1,13 +1,13 @@
 #include "PCH.h"
 #include "Engine/World.h"
-#include "Components/Transform.h"
 #include <unordered_map>
 #include "Pointers.h"
 #include "CLog.h"
 #include "ECS/CoreDetail.h"
+#include "ECS/ComponentDetail.h"
 #include "File.h"
-#include "Resources/JsonResource.h"
 #include "optick.h"
+#include "Work/JobEngine.h"
 
 #define DEFAULT_ENTITY_POOL_SIZE 50
 
@@ -20,6 +20,7 @@ World::World(std::size_t InEntityPoolSize) :
 	EntIdPool(InEntityPoolSize),
 	EntityAttributes(InEntityPoolSize)
 {
+	EntityCache.Alive.resize(InEntityPoolSize);
 }
 
 World::~World()
@@ -47,10 +48,65 @@ BaseCore* World::AddCoreByName(const std::string& core)
 
 EntityHandle World::CreateEntity()
 {
+	AssertNoParallelWave();
 	CheckForResize(1);
 	EntityID id = EntIdPool.Create();
-	EntityCache.Alive[id] = Entity(*this, id);
-	return EntityHandle(id, GetSharedPtr());
+	EntityCache.Alive[id.Index] = Entity(*this, id);
+	++EntityCache.AliveCount;
+	return EntityHandle(id, this);
+}
+
+std::vector<EntityHandle> World::CreateEntities(std::size_t InCount)
+{
+	std::vector<EntityHandle> Handles;
+	std::size_t FirstRow = 0;
+	AllocateEntities(InCount, ComponentTypeArray(), Handles, FirstRow);
+	return Handles;
+}
+
+Archetype* World::AllocateEntities(std::size_t InCount, const ComponentTypeArray& InSignature, std::vector<EntityHandle>& OutHandles, std::size_t& OutFirstRow)
+{
+	OPTICK_EVENT("World::AllocateEntities");
+	AssertNoParallelWave();
+	CheckForResize(InCount);
+
+	std::vector<EntityID> Ids;
+	EntIdPool.Create(InCount, Ids);
+
+	OutHandles.reserve(OutHandles.size() + Ids.size());
+	for (const EntityID& Id : Ids)
+	{
+		EntityCache.Alive[Id.Index] = Entity(*this, Id);
+		OutHandles.emplace_back(Id, this);
+	}
+	EntityCache.AliveCount += Ids.size();
+
+	return EntityAttributes.Storage.AddEntities(Ids, InSignature, OutFirstRow);
+}
+
+void World::ActivateEntities(const std::vector<EntityHandle>& InEntities)
+{
+	EntityCache.Activated.reserve(EntityCache.Activated.size() + InEntities.size());
+	for (const EntityHandle& InEntity : InEntities)
+	{
+		if (Entity* ent = InEntity.Get())
+		{
+			EntityCache.Activated.push_back(*ent);
+		}
+	}
+}
+
+void World::DestroyEntities(const std::vector<EntityHandle>& InEntities)
+{
+	AssertNoParallelWave();
+	EntityCache.Killed.reserve(EntityCache.Killed.size() + InEntities.size());
+	for (const EntityHandle& InEntity : InEntities)
+	{
+		if (Entity* ent = InEntity.Get())
+		{
+			EntityCache.Killed.push_back(*ent);
+		}
+	}
 }
 
 void World::Simulate()
@@ -60,35 +116,50 @@ void World::Simulate()
 		return;
 	}
 	OPTICK_CATEGORY("World::Simulate", Optick::Category::Scene)
+	// Every core has updated since the previous Simulate, older removals have been seen
+	EntityAttributes.Storage.PruneRemoved(LastSimulateTick);
+	LastSimulateTick = AdvanceChangeTick();
+
+	PlaybackCommandBuffers();
+
+	CacheCoreMatches(EntityCache.Activated);
 	for (auto& InEntity : EntityCache.Activated)
 	{
 		auto& Attr = EntityAttributes.Attributes[InEntity.GetId().Index];
 		Attr.IsActive = true;
 
-		for (auto& InCore : Cores)
+		const CoreMatch& Match = GetMatchingCores(EntityAttributes.Storage.GetComponentTypes(InEntity));
+		if (Attr.Cores == Match.Mask)
+		{
+			SyncEntityState(InEntity.GetId());
+			continue;
+		}
+
+		for (TypeId CoreIndex : Match.CoreIds)
 		{
-			if (!InCore.second->IsRunning)
+			if (!Attr.Cores[CoreIndex])
 			{
-				//continue;
+				QueueCoreAdd(CoreIndex, InEntity);
+				Attr.Cores[CoreIndex] = true;
 			}
-			auto CoreIndex = InCore.first;
+		}
 
-			if (InCore.second->GetComponentFilter().PassFilter(EntityAttributes.Storage.GetComponentTypes(InEntity)))
+		if (Attr.Cores.Intersects(~Match.Mask))
+		{
+			for (auto& InCore : Cores)
 			{
-				if (Attr.Cores.size() <= CoreIndex || !Attr.Cores[CoreIndex])
+				auto CoreIndex = InCore.first;
+				if (Attr.Cores[CoreIndex] && !Match.Mask[CoreIndex])
 				{
-					InCore.second->Add(InEntity);
-
-					Attr.Cores[CoreIndex] = true;
+					QueueCoreRemove(CoreIndex, InEntity);
+					Attr.Cores[CoreIndex] = false;
 				}
 			}
-			else if (Attr.Cores.size() > CoreIndex && Attr.Cores[CoreIndex])
-			{
-				InCore.second->Remove(InEntity);
-				Attr.Cores[CoreIndex] = false;
-			}
 		}
+		SyncEntityState(InEntity.GetId());
 	}
+	FlushCoreChanges();
+
 	for (auto& InEntity : EntityCache.Deactivated)
 	{
 		auto& Attr = EntityAttributes.Attributes[InEntity.GetId().Index];
@@ -96,25 +167,174 @@ void World::Simulate()
 		{
 			Attr.IsActive = false;
 
+			if (Attr.Cores.none())
+			{
+				SyncEntityState(InEntity.GetId());
+				continue;
+			}
+
 			for (auto& InCore : Cores)
 			{
 				auto CoreIndex = InCore.first;
-				if (Attr.Cores.size() <= CoreIndex) continue;
 				if (Attr.Cores[CoreIndex])
 				{
-					InCore.second->Remove(InEntity);
+					QueueCoreRemove(CoreIndex, InEntity);
 					Attr.Cores[CoreIndex] = false;
 				}
 			}
+			SyncEntityState(InEntity.GetId());
 		}
 	}
+	FlushCoreChanges();
 
-	for (auto& InEntity : EntityCache.Killed)
+	DestroyKilledEntities();
+
+	EntityCache.ClearTemp();
+}
+
+void World::SyncEntityState(const EntityID& InEntity)
+{
+	const auto& Attr = EntityAttributes.Attributes[InEntity.Index];
+	EntityAttributes.Storage.SetEntityState(InEntity, Attr.IsActive, Attr.Cores);
+}
+
+std::uint32_t World::GetChangeTick() const
+{
+	return ChangeTick;
+}
+
+std::uint32_t World::AdvanceChangeTick()
+{
+	EntityAttributes.Storage.SetCurrentTick(++ChangeTick);
+	return ChangeTick;
+}
+
+void World::MarkComponentChanged(const EntityID& InEntity, TypeId InTypeId)
+{
+	EntityAttributes.Storage.MarkChanged(InEntity, InTypeId);
+}
+
+EntityCommandBuffer& World::GetCommandBuffer()
+{
+	const int WorkerIndex = Jobs ? Jobs->GetThreadWorkerIndex() : -1;
+	if (WorkerIndex >= 0)
 	{
-		DestroyEntity(InEntity, true);
+		return CommandBuffers[WorkerIndex];
 	}
 
-	EntityCache.ClearTemp();
+	std::lock_guard<std::mutex> Lock(ThreadCommandBufferLock);
+	auto Slot = ThreadCommandBufferSlots.try_emplace(std::this_thread::get_id(), ThreadCommandBuffers.size());
+	if (Slot.second)
+	{
+		ThreadCommandBuffers.emplace_back();
+	}
+	return ThreadCommandBuffers[Slot.first->second];
+}
+
+void World::PlaybackCommandBuffers()
+{
+	struct PendingCommand
+	{
+		std::uint32_t SortKey;
+		std::uint32_t Buffer;
+		std::uint32_t Index;
+	};
+
+	const auto IsEmpty = [](const EntityCommandBuffer& InBuffer) {
+		return InBuffer.IsEmpty();
+	};
+
+	// Commands recorded while playing back (from component Init for example) land in fresh buffers for next frame.
+	// Buffers of threads outside the engine are moved in behind the worker ones, their slots stay registered.
+	std::vector<EntityCommandBuffer> Recorded;
+	{
+		std::lock_guard<std::mutex> Lock(ThreadCommandBufferLock);
+		if (std::all_of(CommandBuffers.begin(), CommandBuffers.end(), IsEmpty)
+			&& std::all_of(ThreadCommandBuffers.begin(), ThreadCommandBuffers.end(), IsEmpty))
+		{
+			return;
+		}
+
+		Recorded.resize(CommandBuffers.size());
+		Recorded.swap(CommandBuffers);
+		for (EntityCommandBuffer& Buffer : ThreadCommandBuffers)
+		{
+			Recorded.push_back(std::move(Buffer));
+			Buffer.Clear();
+		}
+	}
+	OPTICK_EVENT("World::PlaybackCommandBuffers");
+
+	std::vector<PendingCommand> Pending;
+	for (std::size_t i = 0; i < Recorded.size(); ++i)
+	{
+		const auto& Commands = Recorded[i].Commands;
+		for (std::size_t j = 0; j < Commands.size(); ++j)
+		{
+			Pending.push_back({ Commands[j].SortKey, static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j) });
+		}
+	}
+
+	std::sort(Pending.begin(), Pending.end(), [](const PendingCommand& A, const PendingCommand& B) {
+		return std::tie(A.SortKey, A.Buffer, A.Index) < std::tie(B.SortKey, B.Buffer, B.Index);
+	});
+
+	for (const PendingCommand& InCommand : Pending)
+	{
+		EntityCommandBuffer& Buffer = Recorded[InCommand.Buffer];
+		auto& Cmd = Buffer.Commands[InCommand.Index];
+
+		// Targets destroyed before playback are skipped
+		Entity* Ent = ResolveCommandTarget(Buffer, Cmd.Entity);
+		if (!Ent)
+		{
+			continue;
+		}
+
+		switch (Cmd.Type)
+		{
+		case EntityCommandBuffer::CommandType::Create:
+			break;
+		case EntityCommandBuffer::CommandType::AddComponent:
+			if (!Ent->HasComponent(Cmd.ComponentType))
+			{
+				Ent->AddComponent(std::move(Cmd.Component), Cmd.ComponentType);
+			}
+			break;
+		case EntityCommandBuffer::CommandType::RemoveComponent:
+			Ent->RemoveComponent(Cmd.ComponentType);
+			// Re-evaluate core membership for the smaller signature
+			if (EntityAttributes.Attributes[Ent->GetId().Index].IsActive)
+			{
+				ActivateEntity(*Ent, true);
+			}
+			break;
+		case EntityCommandBuffer::CommandType::Destroy:
+			Ent->MarkForDelete();
+			break;
+		case EntityCommandBuffer::CommandType::SetActive:
+			Ent->SetActive(Cmd.Active);
+			break;
+		}
+	}
+}
+
+Entity* World::ResolveCommandTarget(EntityCommandBuffer& InBuffer, const EntityCommandBuffer::Target& InTarget)
+{
+	if (InTarget.Deferred < 0)
+	{
+		return GetEntityRaw(InTarget.Entity);
+	}
+
+	// Deferred entities are created by the first command that needs them
+	EntityID& Created = InBuffer.CreatedEntities[InTarget.Deferred];
+	if (Created.IsNull())
+	{
+		Entity* Ent = CreateEntity().Get();
+		Created = Ent->GetId();
+		return Ent;
+	}
+	return GetEntityRaw(Created);
 }
 
 void World::Start()
@@ -143,11 +363,15 @@ void World::Stop()
 
 void World::Destroy()
 {
-	for (auto& it : EntityCache.Alive)
+	for (Entity& InEntity : EntityCache.Alive)
 	{
-		DestroyEntity(it.second, false);
+		if (InEntity)
+		{
+			DestroyEntity(InEntity, false);
+			InEntity = Entity();
+		}
 	}
-	EntityCache.Alive.clear();
+	EntityCache.AliveCount = 0;
 
 	for (auto& core : Cores)
 	{
@@ -159,21 +383,18 @@ void World::Destroy()
 		Cores.erase(core.first);
 	}
 	m_loadedCores.clear();
+	CoreMatchCache.clear();
+	IsCoreScheduleDirty = true;
 	EntityCache.ClearTemp();
 }
 
 void World::Unload()
 {
-	for (auto iter = EntityCache.Alive.begin(); iter != EntityCache.Alive.end(); )
+	for (Entity& InEntity : EntityCache.Alive)
 	{
-		if (iter->second.DestroyOnLoad)
-		{
-			DestroyEntity(iter->second, false);
-			iter = EntityCache.Alive.erase(iter);
-		}
-		else
+		if (InEntity && InEntity.DestroyOnLoad)
 		{
-			++iter;
+			DestroyEntity(InEntity, true);
 		}
 	}
 
@@ -185,53 +406,397 @@ void World::Unload()
 			Cores.erase(core.first);
 		}
 	}
+	CoreMatchCache.clear();
+	IsCoreScheduleDirty = true;
 
 	EntityCache.ClearTemp();
 }
 
-void World::UpdateLoadedCores(const UpdateContext& inUpdateContext)
+WorldSnapshot World::Snapshot()
 {
-	OPTICK_EVENT("UpdateLoadedCores");
-	for (auto core : m_loadedCores)
+	OPTICK_EVENT("World::Snapshot");
+	WorldSnapshot Out;
+	EntIdPool.CopyState(Out.NextId, Out.FreeList, Out.Counters);
+	Out.Entities.reserve(EntityCache.AliveCount);
+
+	SnapshotWriter Writer(Out.Data, &Out.Objects);
+	for (Entity& InEntity : EntityCache.Alive)
 	{
-		if (core.second && core.second->IsRunning)
+		if (!InEntity)
 		{
-			core.second->Update(inUpdateContext);
+			continue;
 		}
+
+		WorldSnapshot::EntityRecord Record;
+		Record.Id = InEntity.GetId();
+		Record.IsActive = EntityAttributes.Attributes[Record.Id.Index].IsActive;
+		Record.DestroyOnLoad = InEntity.DestroyOnLoad;
+		Record.FirstComponent = static_cast<std::uint32_t>(Out.Components.size());
+
+		EntityAttributes.Storage.ForEachComponent(InEntity, [&Out, &Writer](TypeId InType, BaseComponent& InComponent) {
+			WorldSnapshot::ComponentRecord Comp;
+			Comp.Type = InType;
+			Comp.Offset = static_cast<std::uint32_t>(Out.Data.size());
+			InComponent.SaveSnapshot(Writer);
+			Comp.Size = static_cast<std::uint32_t>(Out.Data.size() - Comp.Offset);
+			Out.Components.push_back(Comp);
+		});
+
+		Record.ComponentCount = static_cast<std::uint32_t>(Out.Components.size()) - Record.FirstComponent;
+		Out.Entities.push_back(Record);
 	}
+	return Out;
+}
+
+void World::Restore(const WorldSnapshot& InSnapshot)
+{
+	OPTICK_EVENT("World::Restore");
+
+	// Anything recorded or queued so far targets the state being thrown away
+	for (EntityCommandBuffer& Buffer : CommandBuffers)
+	{
+		Buffer.Clear();
+	}
+	{
+		std::lock_guard<std::mutex> Lock(ThreadCommandBufferLock);
+		for (EntityCommandBuffer& Buffer : ThreadCommandBuffers)
+		{
+			Buffer.Clear();
+		}
+	}
+	EntityCache.ClearTemp();
+
+	// Entities the snapshot doesn't know about, or whose slot has been reused, go away first
+	std::vector<bool> Kept(EntityCache.Alive.size(), false);
+	for (const WorldSnapshot::EntityRecord& Record : InSnapshot.Entities)
+	{
+		if (EntityExists(Record.Id))
+		{
+			Kept[Record.Id.Index] = true;
+		}
+	}
+	for (std::size_t i = 0; i < EntityCache.Alive.size(); ++i)
+	{
+		if (EntityCache.Alive[i] && !Kept[i])
+		{
+			DestroyEntity(EntityCache.Alive[i], true);
+		}
+	}
+
+	if (InSnapshot.Counters.size() > EntIdPool.GetSize())
+	{
+		Resize(InSnapshot.Counters.size());
+	}
+	EntIdPool.RestoreState(InSnapshot.NextId, InSnapshot.FreeList, InSnapshot.Counters);
+
+	// Components are created and filled for every entity before any of them is told, so references between entities resolve
+	std::vector<BaseComponent*> Restored;
+	std::vector<BaseComponent*> Created;
+	Restored.reserve(InSnapshot.Components.size());
+
+	std::vector<TypeId> Stale;
+	for (const WorldSnapshot::EntityRecord& Record : InSnapshot.Entities)
+	{
+		if (!EntityExists(Record.Id))
+		{
+			EntityCache.Alive[Record.Id.Index] = Entity(*this, Record.Id);
+			++EntityCache.AliveCount;
+		}
+
+		Entity& Ent = EntityCache.Alive[Record.Id.Index];
+		Ent.DestroyOnLoad = Record.DestroyOnLoad;
+		Ent.IsLoading = true;
+
+		const WorldSnapshot::ComponentRecord* FirstComponent = InSnapshot.Components.data() + Record.FirstComponent;
+		const WorldSnapshot::ComponentRecord* LastComponent = FirstComponent + Record.ComponentCount;
+
+		Stale.clear();
+		EntityAttributes.Storage.ForEachComponent(Ent, [&Stale, FirstComponent, LastComponent](TypeId InType, BaseComponent&) {
+			if (std::find_if(FirstComponent, LastComponent, [InType](const WorldSnapshot::ComponentRecord& Comp) { return Comp.Type == InType; }) == LastComponent)
+			{
+				Stale.push_back(InType);
+			}
+		});
+		for (TypeId InType : Stale)
+		{
+			Ent.RemoveComponent(InType);
+		}
+
+		for (const WorldSnapshot::ComponentRecord* Comp = FirstComponent; Comp != LastComponent; ++Comp)
+		{
+			BaseComponent* Target = nullptr;
+			if (Ent.HasComponent(Comp->Type))
+			{
+				Target = &Ent.GetComponent(Comp->Type);
+			}
+			else if (const ComponentInfo* Info = GetComponentInfo(Comp->Type))
+			{
+				Target = Info->CreateFunc(Ent);
+				Created.push_back(Target);
+			}
+
+			if (!Target)
+			{
+				CLog::GetInstance().Log(CLog::LogType::Warning, "No factory found to restore component type " + std::to_string(Comp->Type));
+				continue;
+			}
+
+			SnapshotReader Reader(InSnapshot.Data.data() + Comp->Offset, Comp->Size, &InSnapshot.Objects);
+			Target->LoadSnapshot(Reader);
+			EntityAttributes.Storage.MarkChanged(Record.Id, Comp->Type);
+			Restored.push_back(Target);
+		}
+	}
+
+	for (BaseComponent* InComponent : Restored)
+	{
+		InComponent->OnSnapshotRestored();
+	}
+
+	// Components that survived were initialized when they were first added
+	for (BaseComponent* InComponent : Created)
+	{
+		InComponent->Init();
+	}
+
+	for (const WorldSnapshot::EntityRecord& Record : InSnapshot.Entities)
+	{
+		Entity& Ent = EntityCache.Alive[Record.Id.Index];
+		Ent.IsLoading = false;
+		if (Record.IsActive || EntityAttributes.Attributes[Record.Id.Index].IsActive)
+		{
+			ActivateEntity(Ent, Record.IsActive);
+		}
+	}
+}
+
+void World::UpdateLoadedCores(const UpdateContext& inUpdateContext)
+{
+	OPTICK_EVENT("UpdateLoadedCores");
+	RunCoreSchedule(inUpdateContext, false);
 }
 
 void World::LateUpdateLoadedCores(const UpdateContext& inUpdateContext)
 {
 	OPTICK_EVENT("UpdateLoadedCores");
-	for (auto core : m_loadedCores)
+	RunCoreSchedule(inUpdateContext, true);
+}
+
+void World::SetJobEngine(JobEngine* InJobEngine)
+{
+	CommandBuffers.resize(InJobEngine ? InJobEngine->GetWorkerCount() : 0);
+	Jobs = InJobEngine;
+}
+
+JobEngine* World::GetJobEngine() const
+{
+	return Jobs;
+}
+
+void World::SetEngineCores(const std::vector<BaseCore*>& InCores)
+{
+	BuildCoreWaves(InCores, EngineCoreSchedule);
+}
+
+void World::UpdateEngineCores(const UpdateContext& inUpdateContext)
+{
+	OPTICK_EVENT("UpdateEngineCores");
+	RunCoreWaves(EngineCoreSchedule, inUpdateContext, false, false);
+}
+
+void World::UpdateUnscheduledCore(BaseCore& InCore, const UpdateContext& inUpdateContext)
+{
+	UpdateCore(InCore, inUpdateContext, false, GetChangeTick());
+	// Anything written from here on has to be newer than the tick the core just recorded
+	AdvanceChangeTick();
+}
+
+void World::BuildCoreWaves(const std::vector<BaseCore*>& InOrderedCores, CoreWaves& OutWaves)
+{
+	OutWaves.clear();
+	std::vector<std::size_t> CoreWave(InOrderedCores.size(), 0);
+	for (std::size_t i = 0; i < InOrderedCores.size(); ++i)
 	{
-		if (core.second && core.second->IsRunning)
+		// Place each core after every earlier core it conflicts with
+		for (std::size_t j = 0; j < i; ++j)
 		{
-			core.second->LateUpdate(inUpdateContext);
+			if (InOrderedCores[i]->GetComponentFilter().ConflictsWith(InOrderedCores[j]->GetComponentFilter()))
+			{
+				CoreWave[i] = std::max(CoreWave[i], CoreWave[j] + 1);
+			}
 		}
+
+		CheckCapacity(OutWaves, CoreWave[i]);
+		OutWaves[CoreWave[i]].push_back(InOrderedCores[i]);
 	}
 }
 
+void World::RebuildCoreSchedule()
+{
+	std::vector<BaseCore*> OrderedCores;
+	for (auto& core : m_loadedCores)
+	{
+		if (core.second)
+		{
+			OrderedCores.push_back(core.second);
+		}
+	}
+
+	// unordered_map order isn't stable between runs, the name is
+	std::sort(OrderedCores.begin(), OrderedCores.end(), [](BaseCore* A, BaseCore* B) {
+		return A->GetName() < B->GetName();
+	});
+
+	BuildCoreWaves(OrderedCores, CoreSchedule);
+	IsCoreScheduleDirty = false;
+}
+
+void World::RunCoreSchedule(const UpdateContext& inUpdateContext, bool InLateUpdate)
+{
+	if (IsCoreScheduleDirty)
+	{
+		RebuildCoreSchedule();
+	}
+
+	RunCoreWaves(CoreSchedule, inUpdateContext, InLateUpdate, true);
+}
+
+void World::RunCoreWaves(CoreWaves& InWaves, const UpdateContext& inUpdateContext, bool InLateUpdate, bool InSkipStopped)
+{
+	Worker* worker = Jobs ? Jobs->GetThreadWorker() : nullptr;
+	std::vector<BaseCore*> WaveCores;
+	for (std::vector<BaseCore*>& Wave : InWaves)
+	{
+		// Earlier waves advanced the tick when they finished, so whatever this wave writes is newer than what they saw
+		const std::uint32_t WaveTick = GetChangeTick();
+
+		WaveCores.clear();
+		for (BaseCore* core : Wave)
+		{
+			if (core->IsRunning || !InSkipStopped)
+			{
+				WaveCores.push_back(core);
+			}
+		}
+
+		if (!worker || WaveCores.size() < 2)
+		{
+			for (BaseCore* core : WaveCores)
+			{
+				UpdateCore(*core, inUpdateContext, InLateUpdate, WaveTick);
+			}
+		}
+		else
+		{
+			// The first core stays on this thread, BuildCoreWaves leaves at most one main thread core per wave
+			auto mainThreadCore = std::find_if(WaveCores.begin(), WaveCores.end(), [](BaseCore* core) {
+				return core->GetComponentFilter().RequiresMainThread();
+			});
+			if (mainThreadCore != WaveCores.end())
+			{
+				std::iter_swap(WaveCores.begin(), mainThreadCore);
+			}
+
+			IsUpdatingParallelWave = true;
+			Job* rootJob = worker->GetPool().CreateClosureJob([](Job&) {
+			});
+			for (std::size_t i = 1; i < WaveCores.size(); ++i)
+			{
+				BaseCore* core = WaveCores[i];
+				Job* coreJob = worker->GetPool().CreateClosureJobAsChild([core, &inUpdateContext, InLateUpdate, WaveTick](Job&) {
+					OPTICK_EVENT("World::UpdateCore");
+					UpdateCore(*core, inUpdateContext, InLateUpdate, WaveTick);
+				}, rootJob);
+				worker->Submit(coreJob);
+			}
+			worker->Submit(rootJob);
+
+			UpdateCore(*WaveCores[0], inUpdateContext, InLateUpdate, WaveTick);
+			worker->Wait(rootJob);
+			IsUpdatingParallelWave = false;
+		}
+
+		// The wave's cores recorded WaveTick, writes made after them (later waves, gameplay) must compare newer
+		AdvanceChangeTick();
+	}
+}
+
+void World::UpdateCore(BaseCore& InCore, const UpdateContext& inUpdateContext, bool InLateUpdate, std::uint32_t InTick)
+{
+	if (InLateUpdate)
+	{
+		InCore.LateUpdate(inUpdateContext);
+		return;
+	}
+
+	InCore.Update(inUpdateContext);
+	InCore.LastUpdateTick = InTick;
+}
+
 void World::DestroyEntity(Entity &InEntity, bool RemoveFromWorld)
 {
 	auto& Attr = EntityAttributes.Attributes[InEntity.GetId().Index];
-	Attr.IsActive = false;
+	const CoreMatch& Match = GetMatchingCores(EntityAttributes.Storage.GetComponentTypes(InEntity));
+	for (TypeId CoreIndex : Match.CoreIds)
+	{
+		if (Attr.Cores[CoreIndex])
+		{
+			Cores[CoreIndex]->Remove(InEntity);
+		}
+	}
+	ReleaseEntity(InEntity, RemoveFromWorld);
+}
+
+void World::DestroyKilledEntities()
+{
+	if (EntityCache.Killed.empty())
+	{
+		return;
+	}
+	OPTICK_EVENT("World::DestroyKilledEntities");
+
+	// Leave every core in one batch per core first
+	for (auto& InEntity : EntityCache.Killed)
 	{
-		for (auto& InCore : Cores)
+		if (!EntityExists(InEntity.GetId()))
 		{
-			auto CoreIndex = InCore.first;
+			continue;
+		}
 
-			if (InCore.second->GetComponentFilter().PassFilter(EntityAttributes.Storage.GetComponentTypes(InEntity)))
+		auto& Attr = EntityAttributes.Attributes[InEntity.GetId().Index];
+		const CoreMatch& Match = GetMatchingCores(EntityAttributes.Storage.GetComponentTypes(InEntity));
+		for (TypeId CoreIndex : Match.CoreIds)
+		{
+			if (Attr.Cores[CoreIndex])
 			{
-				if (Attr.Cores.size() >= CoreIndex)
-				{
-					InCore.second->Remove(InEntity);
-					InCore.second->OnEntityDestroyed(InEntity);
-				}
+				QueueCoreRemove(CoreIndex, InEntity);
+				Attr.Cores[CoreIndex] = false;
 			}
 		}
 	}
+	FlushCoreChanges();
+
+	// Entities can be marked more than once in a frame
+	for (auto& InEntity : EntityCache.Killed)
+	{
+		if (EntityExists(InEntity.GetId()))
+		{
+			ReleaseEntity(InEntity, true);
+		}
+	}
+}
+
+void World::ReleaseEntity(Entity& InEntity, bool RemoveFromWorld)
+{
+	auto& Attr = EntityAttributes.Attributes[InEntity.GetId().Index];
+	Attr.IsActive = false;
+
+	const CoreMatch& Match = GetMatchingCores(EntityAttributes.Storage.GetComponentTypes(InEntity));
+	for (TypeId CoreIndex : Match.CoreIds)
+	{
+		Cores[CoreIndex]->OnEntityDestroyed(InEntity);
+	}
+
 	EntityAttributes.Storage.RemoveAllComponents(InEntity);
 	Attr.Cores.reset();
 
@@ -239,74 +804,111 @@ void World::DestroyEntity(Entity &InEntity, bool RemoveFromWorld)
 
 	if (RemoveFromWorld)
 	{
-		auto it = EntityCache.Alive.find(InEntity.GetId());
-		if (it != EntityCache.Alive.end())
-		{
-			EntityCache.Alive.erase(it);
-		}
+		ReleaseEntitySlot(InEntity.GetId());
 	}
 }
 
-EntityHandle World::CreateFromPrefab(std::string& FilePath, Transform* Parent)
+void World::ReleaseEntitySlot(const EntityID& InEntity)
 {
-	OPTICK_EVENT("World::CreateFromPrefab");
-	//File PrefabSource = File(Path(FilePath));
-	SharedPtr<JsonResource> prefabJson = ResourceCache::GetInstance().Get<JsonResource>(Path(FilePath));
-	//nlohmann::json Prefab = nlohmann::json::parse(PrefabSource.Read());
-	return LoadPrefab(prefabJson->GetJson(), Parent, Parent);
+	if (EntityExists(InEntity))
+	{
+		EntityCache.Alive[InEntity.Index] = Entity();
+		--EntityCache.AliveCount;
+	}
+}
+
+const World::CoreMatch& World::GetMatchingCores(const ComponentTypeArray& InSignature)
+{
+	auto it = CoreMatchCache.find(InSignature);
+	if (it != CoreMatchCache.end())
+	{
+		return it->second;
+	}
+
+	CoreMatch& Match = CoreMatchCache[InSignature];
+	for (auto& InCore : Cores)
+	{
+		if (InCore.second && InCore.second->GetComponentFilter().PassFilter(InSignature))
+		{
+			Match.CoreIds.push_back(InCore.first);
+			Match.Mask[InCore.first] = true;
+		}
+	}
+	return Match;
 }
 
-EntityHandle World::LoadPrefab(const json& obj, Transform* parent, Transform* root)
+void World::CacheCoreMatches(const EntityArray& InEntities)
 {
-	EntityHandle ent;
-	World* GameWorld = this;
-	if (parent && parent != root)
+	std::vector<ComponentTypeArray> Signatures;
+	for (const Entity& InEntity : InEntities)
 	{
-		auto t = parent->GetChildByName(obj["Name"]);
-		if (t)
+		const ComponentTypeArray& Signature = EntityAttributes.Storage.GetComponentTypes(InEntity);
+		if (CoreMatchCache.find(Signature) == CoreMatchCache.end()
+			&& std::find(Signatures.begin(), Signatures.end(), Signature) == Signatures.end())
 		{
-			ent = t->Parent;
+			Signatures.push_back(Signature);
 		}
 	}
-	if (!ent)
+
+	if (Signatures.empty())
+	{
+		return;
+	}
+
+	std::vector<CoreMatch*> Matches;
+	Matches.reserve(Signatures.size());
+	for (const ComponentTypeArray& Signature : Signatures)
 	{
-		ent = GameWorld->CreateEntity();
+		Matches.push_back(&CoreMatchCache[Signature]);
 	}
-	ent->IsLoading = true;
-	Transform* transComp = nullptr;
-	for (const json& comp : obj["Components"])
+
+	std::unique_ptr<bool[]> Passed(new bool[Signatures.size()]);
+	for (auto& InCore : Cores)
 	{
-		if (comp.is_null())
+		if (!InCore.second || !InCore.second->GetComponentFilter().PassFilter(Signatures.data(), Signatures.size(), Passed.get()))
 		{
 			continue;
 		}
-		BaseComponent* addedComp = ent->AddComponentByName(comp["Type"]);
-		if (comp["Type"] == "Transform")
+
+		for (std::size_t i = 0; i < Signatures.size(); ++i)
 		{
-			transComp = static_cast<Transform*>(addedComp);
-			if (parent)
+			if (Passed[i])
 			{
-				transComp->SetParent(*parent);
+				Matches[i]->CoreIds.push_back(InCore.first);
+				Matches[i]->Mask[InCore.first] = true;
 			}
-			transComp->SetName(obj["Name"]);
-		}
-		if (addedComp)
-		{
-			addedComp->Deserialize(comp);
-			addedComp->Init();
 		}
 	}
-	ent->SetActive(true);
-	ent->IsLoading = false;
+}
+
+void World::QueueCoreAdd(TypeId InCoreId, const Entity& InEntity)
+{
+	CheckCapacity(PendingCoreAdds, InCoreId);
+	PendingCoreAdds[InCoreId].push_back(InEntity);
+}
 
-	if (obj.contains("Children"))
+void World::QueueCoreRemove(TypeId InCoreId, const Entity& InEntity)
+{
+	CheckCapacity(PendingCoreRemoves, InCoreId);
+	PendingCoreRemoves[InCoreId].push_back(InEntity);
+}
+
+void World::FlushCoreChanges()
+{
+	for (auto& InCore : Cores)
 	{
-		for (const json& child : obj["Children"])
+		const TypeId CoreIndex = InCore.first;
+		if (CoreIndex < PendingCoreRemoves.size() && !PendingCoreRemoves[CoreIndex].empty())
+		{
+			InCore.second->RemoveEntities(PendingCoreRemoves[CoreIndex]);
+			PendingCoreRemoves[CoreIndex].clear();
+		}
+		if (CoreIndex < PendingCoreAdds.size() && !PendingCoreAdds[CoreIndex].empty())
 		{
-			LoadPrefab(child, transComp, root);
+			InCore.second->AddEntities(PendingCoreAdds[CoreIndex]);
+			PendingCoreAdds[CoreIndex].clear();
 		}
 	}
-	return ent;
 }
 
 SharedPtr<World> World::GetSharedPtr()
@@ -321,10 +923,12 @@ void World::AddCore(BaseCore& InCore, TypeId InCoreTypeId, bool HandleUpdate)
 		Cores[InCoreTypeId].reset(&InCore);
 	}
 	InCore.GameWorld = this;
+	CoreMatchCache.clear();
 	InCore.Init();
 	if (HandleUpdate)
 	{
 		m_loadedCores[InCoreTypeId] = Cores[InCoreTypeId].get();
+		IsCoreScheduleDirty = true;
 	}
 // 	for (auto ent : EntityCache.Alive)
 // 	{
@@ -363,9 +967,10 @@ void World::CheckForResize(std::size_t InNumEntitiesToBeAllocated)
 {
 	auto NewSize = GetEntityCount() + InNumEntitiesToBeAllocated;
 
+	// Grow geometrically so spawning one entity at a time doesn't resize every call
 	if (NewSize > EntIdPool.GetSize())
 	{
-		Resize(NewSize);
+		Resize(std::max(NewSize, EntIdPool.GetSize() * 2));
 	}
 }
 
@@ -373,43 +978,27 @@ void World::Resize(std::size_t InAmount)
 {
 	EntIdPool.Resize(InAmount);
 	EntityAttributes.Resize(InAmount);
+	EntityCache.Alive.resize(InAmount);
 }
 
 std::size_t World::GetEntityCount() const
 {
-	return EntityCache.Alive.size();
+	return EntityCache.AliveCount;
 }
 
 EntityHandle World::GetEntity(const EntityID& InEntity)
 {
-	auto it = EntityCache.Alive.find(InEntity);
-	if (it != EntityCache.Alive.end())
+	if (EntityExists(InEntity))
 	{
-		return EntityHandle(InEntity, GetSharedPtr());
+		return EntityHandle(InEntity, this);
 	}
 
 	return {};
 }
 
-Entity* World::GetEntityRaw(const EntityID& InEntity)
-{
-	auto it = EntityCache.Alive.find(InEntity);
-	if (it != EntityCache.Alive.end())
-	{
-		return &EntityCache.Alive[InEntity];
-	}
-
-	return nullptr;
-}
-
-const bool World::EntityExists(const EntityID& InEntity) const
-{
-	auto it = EntityCache.Alive.find(InEntity);
-	return (it != EntityCache.Alive.end());
-}
-
 void World::ActivateEntity(Entity& InEntity, const bool InActive)
 {
+	AssertNoParallelWave();
 	if (InActive)
 	{
 		EntityCache.Activated.push_back(InEntity);
@@ -422,6 +1011,7 @@ void World::ActivateEntity(Entity& InEntity, const bool InActive)
 
 void World::MarkEntityForDelete(Entity& EntityToDestroy)
 {
+	AssertNoParallelWave();
 	//EntityCache.Deactivated.push_back(EntityToDestroy);
 	EntityCache.Killed.push_back(EntityToDestroy);
 }
@@ -6,26 +6,35 @@
 #include "ECS/EntityHandle.h"
 #include "ECS/Core.h"
 #include "ECS/ComponentStorage.h"
+#include "ECS/EntityCommandBuffer.h"
 #include "ECS/EntityIdPool.h"
+#include "Engine/WorldSnapshot.h"
 #include "Resource/ResourceCache.h"
 #include "Pointers.h"
 #include <JSON.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 class Transform;
+class JobEngine;
+
+template<typename... Ts>
+class ComponentQuery;
 
 class World
 	: public std::enable_shared_from_this<World>
 {
 private:
 	typedef std::vector<Entity> EntityArray;
-	typedef std::unordered_map<EntityID, Entity, EntityIDHash> MasterEntityArray;
 
 	struct CoreDeleter
 	{
 		void operator() (BaseCore* InCore) const
 		{
 			InCore->GameWorld = nullptr;
-			InCore->Entities.clear();
+			InCore->Clear();
 		}
 	};
 
@@ -34,6 +43,9 @@ private:
 	// Access to components
 	friend class Entity;
 
+	template<typename... Ts>
+	friend class ComponentQuery;
+
 
 public:
 	SharedPtr<World> GetSharedPtr();
@@ -56,6 +68,23 @@ public:
 
 	EntityHandle CreateEntity();
 
+	// Create InCount entities in one go, ids are allocated as a block and storage grows at most once.
+	std::vector<EntityHandle> CreateEntities(std::size_t InCount);
+
+	// Same as above but every entity starts out owning default constructed Ts..., placed directly in their archetype.
+	template<typename... Ts>
+	std::vector<EntityHandle> CreateEntities(std::size_t InCount);
+
+	// Mark a batch of entities for delete, they leave their cores together during the next Simulate.
+	void DestroyEntities(const std::vector<EntityHandle>& InEntities);
+
+	// Iterate entities owning all of Ts..., see ComponentQuery.h
+	template<typename... Ts>
+	ComponentQuery<Ts...> Query();
+
+	template<typename... Ts, typename Func>
+	void Each(Func&& InFunc);
+
 	void Simulate();
 	void Start();
 	void Stop();
@@ -64,17 +93,58 @@ public:
 
 	void Unload();
 
+	// Capture every entity, its id, active state and raw component state, see WorldSnapshot.h.
+	// Take it between Simulates, entities activated since the last one are stored as inactive.
+	WorldSnapshot Snapshot();
+
+	// Bring the world back to InSnapshot. Entities that still exist keep their component instances and get their state
+	// written back in place, others are destroyed or recreated under their old ids. Pending commands are dropped and
+	// core membership is re-evaluated during the next Simulate. Cores themselves are left untouched.
+	void Restore(const WorldSnapshot& InSnapshot);
+
+	// Loaded cores are grouped into waves of cores with non-conflicting component access (see ComponentFilter::Reads/Writes).
+	// Cores within a wave are updated concurrently on the job engine, waves run in a deterministic order.
+	// Cores sharing a wave may not make structural changes (create, destroy or (de)activate entities, add or remove components),
+	// those have to be recorded with GetCommandBuffer(). Debug builds assert on it.
 	void UpdateLoadedCores(const UpdateContext& inUpdateContext);
 	void LateUpdateLoadedCores(const UpdateContext& inUpdateContext);
 
+	// Engine owned cores that update after the game, listed in the order they depend on each other.
+	// They are split into waves the same way loaded cores are, stopped cores still update.
+	void SetEngineCores(const std::vector<BaseCore*>& InCores);
+	void UpdateEngineCores(const UpdateContext& inUpdateContext);
+
+	// Update a core outside of any schedule, its LastUpdateTick is stamped just like for scheduled cores
+	void UpdateUnscheduledCore(BaseCore& InCore, const UpdateContext& inUpdateContext);
+
+	void SetJobEngine(JobEngine* InJobEngine);
+	JobEngine* GetJobEngine() const;
+
+	// Advances every Simulate and before every wave of core updates, component writes are stamped with it
+	std::uint32_t GetChangeTick() const;
+
+	// Stamp a component as written, for writes that don't go through a mutable query
+	void MarkComponentChanged(const EntityID& InEntity, TypeId InTypeId);
+
+	// Calls InFunc(const EntityID&) for every entity that lost its T (or was destroyed) after InSinceTick.
+	// Removals are kept until the Simulate after next, so cores updating every frame see all of them.
+	template<typename T, typename Func>
+	void ForEachRemoved(std::uint32_t InSinceTick, Func&& InFunc) const;
+
+	// Command buffer owned by the calling job engine worker, safe to record into from jobs.
+	// Other threads get a buffer of their own on first use, they must not record while Simulate runs.
+	// Recorded changes are applied at the start of the next Simulate.
+	EntityCommandBuffer& GetCommandBuffer();
+
 	void MarkEntityForDelete(Entity& EntityToDestroy);
 
 	EntityHandle CreateFromPrefab(std::string& FilePath, Transform* Parent = nullptr);
 
 	std::size_t GetEntityCount() const;
 	EntityHandle GetEntity(const EntityID& id);
-	Entity* GetEntityRaw(const EntityID& id);
-	const bool EntityExists(const EntityID& InEntity) const;
+	// The returned pointer is only stable until the next entity is created
+	inline Entity* GetEntityRaw(const EntityID& id);
+	inline const bool EntityExists(const EntityID& InEntity) const;
 	World();
 	World(std::size_t InEntityPoolSize);
 	~World();
@@ -95,7 +165,7 @@ private:
 		{
 			bool IsActive;
 
-			std::bitset<64> Cores;
+			CoreTypeArray Cores;
 		};
 
 		TEntityAttributes(std::size_t InEntityAmount) :
@@ -123,7 +193,9 @@ private:
 
 	struct TEntityCache
 	{
-		MasterEntityArray Alive;
+		// Registry indexed by EntityID::Index, a slot is alive if it has a world and its counter matches the id
+		EntityArray Alive;
+		std::size_t AliveCount = 0;
 		EntityArray Killed;
 		EntityArray Activated;
 		EntityArray Deactivated;
@@ -138,8 +210,85 @@ private:
 
 	EntityCache;
 
+	// Cores whose filter passes a given component signature, filled lazily and dropped whenever the core list changes
+	struct CoreMatch
+	{
+		std::vector<TypeId> CoreIds;
+		CoreTypeArray Mask;
+	};
+	std::unordered_map<ComponentTypeArray, CoreMatch> CoreMatchCache;
+
+	// Per core membership changes gathered during Simulate, indexed by core TypeId
+	std::vector<EntityArray> PendingCoreAdds;
+	std::vector<EntityArray> PendingCoreRemoves;
+
+	const CoreMatch& GetMatchingCores(const ComponentTypeArray& InSignature);
+
+	// Fill the match cache for every uncached signature in InEntities, running each core filter over the whole batch
+	void CacheCoreMatches(const EntityArray& InEntities);
+
+	JobEngine* Jobs = nullptr;
+
+	std::uint32_t ChangeTick = 0;
+	std::uint32_t LastSimulateTick = 0;
+
+	std::uint32_t AdvanceChangeTick();
+
+	// One per job engine worker
+	std::vector<EntityCommandBuffer> CommandBuffers;
+
+	// One per thread outside of the engine, registered on first use. A deque keeps the buffers handed out in place as others are added.
+	std::deque<EntityCommandBuffer> ThreadCommandBuffers;
+	std::unordered_map<std::thread::id, std::size_t> ThreadCommandBufferSlots;
+	std::mutex ThreadCommandBufferLock;
+
+	void PlaybackCommandBuffers();
+
+	Entity* ResolveCommandTarget(EntityCommandBuffer& InBuffer, const EntityCommandBuffer::Target& InTarget);
+
+	typedef std::vector<std::vector<BaseCore*>> CoreWaves;
+
+	CoreWaves CoreSchedule;
+	CoreWaves EngineCoreSchedule;
+	bool IsCoreScheduleDirty = true;
+
+	// Set while the cores of a wave update concurrently
+	bool IsUpdatingParallelWave = false;
+
+	void RebuildCoreSchedule();
+	void RunCoreSchedule(const UpdateContext& inUpdateContext, bool InLateUpdate);
+	static void BuildCoreWaves(const std::vector<BaseCore*>& InOrderedCores, CoreWaves& OutWaves);
+	void RunCoreWaves(CoreWaves& InWaves, const UpdateContext& inUpdateContext, bool InLateUpdate, bool InSkipStopped);
+
+	inline void AssertNoParallelWave() const
+	{
+		assert(!IsUpdatingParallelWave && "Structural changes aren't allowed while cores update in parallel, record them with GetCommandBuffer()");
+	}
+	static void UpdateCore(BaseCore& InCore, const UpdateContext& inUpdateContext, bool InLateUpdate, std::uint32_t InTick);
+
+	void QueueCoreAdd(TypeId InCoreId, const Entity& InEntity);
+	void QueueCoreRemove(TypeId InCoreId, const Entity& InEntity);
+	void FlushCoreChanges();
+
+	// Mirrors IsActive and core membership into the entity's archetype row for ComponentQuery
+	void SyncEntityState(const EntityID& InEntity);
+
 	void DestroyEntity(Entity& InEntity, bool RemoveFromWorld = true);
 
+	// Everything DestroyEntity does after the entity has left its cores
+	void ReleaseEntity(Entity& InEntity, bool RemoveFromWorld);
+
+	void DestroyKilledEntities();
+
+	Archetype* AllocateEntities(std::size_t InCount, const ComponentTypeArray& InSignature, std::vector<EntityHandle>& OutHandles, std::size_t& OutFirstRow);
+
+	void ActivateEntities(const std::vector<EntityHandle>& InEntities);
+
+	template<typename T>
+	SharedPtr<BaseComponent> CreateComponentFor(const EntityHandle& InEntity);
+
+	void ReleaseEntitySlot(const EntityID& InEntity);
+
 	void AddCore(BaseCore& InCore, TypeId InCoreTypeId, bool HandleUpdate = false);
 
 	void CheckForResize(std::size_t InNumEntitiesToBeAllocated);
@@ -172,3 +321,98 @@ bool World::HasCore()
 {
 	return Cores.find(TCore::GetTypeId()) != Cores.end();
 }
+
+namespace details
+{
+	template<typename T, typename... Ts>
+	constexpr bool AreDistinct()
+	{
+		if constexpr (sizeof...(Ts) == 0)
+		{
+			return true;
+		}
+		else
+		{
+			return !(std::is_same_v<T, Ts> || ...) && AreDistinct<Ts...>();
+		}
+	}
+}
+
+template<typename... Ts>
+std::vector<EntityHandle> World::CreateEntities(std::size_t InCount)
+{
+	static_assert(sizeof...(Ts) > 0, "Use CreateEntities(InCount) for entities without components");
+	static_assert(details::AreDistinct<Ts...>(), "CreateEntities lists the same component type more than once");
+
+	ComponentTypeArray Signature;
+	(Signature.set(Ts::GetTypeId()), ...);
+
+	std::vector<EntityHandle> Handles;
+	std::size_t FirstRow = 0;
+	Archetype* Target = AllocateEntities(InCount, Signature, Handles, FirstRow);
+
+	for (std::size_t i = 0; i < Handles.size(); ++i)
+	{
+		const std::size_t Row = FirstRow + i;
+		((Target->GetComponent(Row, Target->GetColumn(Ts::GetTypeId())) = CreateComponentFor<Ts>(Handles[i])), ...);
+	}
+
+	// Init once every entity of the block owns all of its components, in the archetype's column order
+	const int ColumnCount = static_cast<int>(Target->GetTypes().size());
+	for (std::size_t i = 0; i < Handles.size(); ++i)
+	{
+		for (int Column = 0; Column < ColumnCount; ++Column)
+		{
+			Target->GetComponent(FirstRow + i, Column)->Init();
+		}
+	}
+
+	ActivateEntities(Handles);
+	return Handles;
+}
+
+template<typename T, typename Func>
+void World::ForEachRemoved(std::uint32_t InSinceTick, Func&& InFunc) const
+{
+	for (const ComponentStorage::RemovedComponent& InRemoved : EntityAttributes.Storage.GetRemoved(T::GetTypeId()))
+	{
+		if (InRemoved.Tick > InSinceTick)
+		{
+			InFunc(InRemoved.Entity);
+		}
+	}
+}
+
+template<typename T>
+SharedPtr<BaseComponent> World::CreateComponentFor(const EntityHandle& InEntity)
+{
+	static_assert(std::is_base_of<BaseComponent, T>(), "T is not a component");
+	SharedPtr<T> component = MakeComponent<T>();
+	component->Parent = InEntity;
+	return component;
+}
+
+inline Entity* World::GetEntityRaw(const EntityID& InEntity)
+{
+	if (InEntity.Index < EntityCache.Alive.size())
+	{
+		Entity& entity = EntityCache.Alive[InEntity.Index];
+		if (entity.GameWorld && entity.Id.Counter == InEntity.Counter)
+		{
+			return &entity;
+		}
+	}
+	return nullptr;
+}
+
+inline const bool World::EntityExists(const EntityID& InEntity) const
+{
+	if (InEntity.Index < EntityCache.Alive.size())
+	{
+		const Entity& entity = EntityCache.Alive[InEntity.Index];
+		return entity.GameWorld && entity.Id.Counter == InEntity.Counter;
+	}
+	return false;
+}
+
+#include "ECS/ComponentQuery.h"
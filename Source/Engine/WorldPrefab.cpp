@@ -0,0 +1,69 @@
+#include "PCH.h"
+#include "Engine/World.h"
+#include "Components/Transform.h"
+#include "Resources/JsonResource.h"
+#include "optick.h"
+
+// Prefab loading lives outside World.cpp because it needs Transform, so the ECS can build without the Engine components.
+
+EntityHandle World::CreateFromPrefab(std::string& FilePath, Transform* Parent)
+{
+	OPTICK_EVENT("World::CreateFromPrefab");
+	//File PrefabSource = File(Path(FilePath));
+	SharedPtr<JsonResource> prefabJson = ResourceCache::GetInstance().Get<JsonResource>(Path(FilePath));
+	//nlohmann::json Prefab = nlohmann::json::parse(PrefabSource.Read());
+	return LoadPrefab(prefabJson->GetJson(), Parent, Parent);
+}
+
+EntityHandle World::LoadPrefab(const json& obj, Transform* parent, Transform* root)
+{
+	EntityHandle ent;
+	World* GameWorld = this;
+	if (parent && parent != root)
+	{
+		auto t = parent->GetChildByName(obj["Name"]);
+		if (t)
+		{
+			ent = t->Parent;
+		}
+	}
+	if (!ent)
+	{
+		ent = GameWorld->CreateEntity();
+	}
+	ent->IsLoading = true;
+	Transform* transComp = nullptr;
+	for (const json& comp : obj["Components"])
+	{
+		if (comp.is_null())
+		{
+			continue;
+		}
+		BaseComponent* addedComp = ent->AddComponentByName(comp["Type"]);
+		if (comp["Type"] == "Transform")
+		{
+			transComp = static_cast<Transform*>(addedComp);
+			if (parent)
+			{
+				transComp->SetParent(*parent);
+			}
+			transComp->SetName(obj["Name"]);
+		}
+		if (addedComp)
+		{
+			addedComp->Deserialize(comp);
+			addedComp->Init();
+		}
+	}
+	ent->SetActive(true);
+	ent->IsLoading = false;
+
+	if (obj.contains("Children"))
+	{
+		for (const json& child : obj["Children"])
+		{
+			LoadPrefab(child, transComp, root);
+		}
+	}
+	return ent;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ClassTypeId.h"
+#include "ECS/EntityID.h"
+
+// In-memory copy of every entity in a World, taken with World::Snapshot and applied with World::Restore.
+// Components are stored as raw bytes written by their SaveSnapshot hook, nothing goes through the file system.
+class WorldSnapshot
+{
+	friend class World;
+public:
+	bool IsEmpty() const
+	{
+		return Entities.empty();
+	}
+
+	std::size_t GetEntityCount() const
+	{
+		return Entities.size();
+	}
+
+	// Bytes held by the snapshot, component payloads and bookkeeping
+	std::size_t GetSize() const
+	{
+		return Data.size()
+			+ Entities.size() * sizeof(EntityRecord)
+			+ Components.size() * sizeof(ComponentRecord)
+			+ FreeList.size() * sizeof(EntityID)
+			+ Counters.size() * sizeof(EntityID::IntType)
+			+ Objects.size() * sizeof(std::shared_ptr<void>);
+	}
+
+	void Clear()
+	{
+		Entities.clear();
+		Components.clear();
+		Data.clear();
+		Objects.clear();
+		FreeList.clear();
+		Counters.clear();
+		NextId = 0;
+	}
+
+private:
+	struct EntityRecord
+	{
+		EntityID Id;
+		std::uint32_t FirstComponent = 0;
+		std::uint32_t ComponentCount = 0;
+		bool IsActive = false;
+		bool DestroyOnLoad = true;
+	};
+
+	struct ComponentRecord
+	{
+		TypeId Type = 0;
+		std::uint32_t Offset = 0;
+		std::uint32_t Size = 0;
+	};
+
+	std::vector<EntityRecord> Entities;
+	std::vector<ComponentRecord> Components;
+	std::vector<std::uint8_t> Data;
+	// Non-trivial state the component payloads refer to by index, see SnapshotWriter::WriteObject
+	std::vector<std::shared_ptr<void>> Objects;
+
+	// Entity id pool state, so ids handed out after a restore match the ones handed out after the snapshot
+	std::size_t NextId = 0;
+	std::vector<EntityID> FreeList;
+	std::vector<EntityID::IntType> Counters;
+};
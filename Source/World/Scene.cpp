@@ -138,11 +138,11 @@ void Scene::SaveSceneRecursively(json& d, Transform* CurrentTransform)
 		comp->Serialize(compJson);
 		componentsJson.push_back(compJson);
 	}
-	if (CurrentTransform->GetChildren().size() > 0)
+	if (CurrentTransform->HasChildren())
 	{
-		for (SharedPtr<Transform> Child : CurrentTransform->GetChildren())
+		for (Transform* Child : CurrentTransform->GetChildren())
 		{
-			SaveSceneRecursively(outEntity["Children"], Child.get());
+			SaveSceneRecursively(outEntity["Children"], Child);
 		}
 	}
 	d.push_back(outEntity);
@@ -156,11 +156,11 @@ void Scene::Save(const std::string& fileName, Transform* root)
 	File worldFile(FilePath);
 	json world;
 
-	if (root->GetChildren().size() > 0)
+	if (root->HasChildren())
 	{
-		for (SharedPtr<Transform> Child : root->GetChildren())
+		for (Transform* Child : root->GetChildren())
 		{
-			SaveSceneRecursively(world["Scene"], Child.get());
+			SaveSceneRecursively(world["Scene"], Child);
 		}
 	}
 
@@ -0,0 +1,28 @@
+using Sharpmake;
+
+// Headless ECS microbenchmarks, never opens a window. Links the engine for TransformBenchmarks.cpp,
+// Linux builds the ECS only benchmarks from CMakeLists.txt instead.
+[Generate]
+public class ECSBenchmarkProject : BaseProject
+{
+    public ECSBenchmarkProject()
+        : base()
+    {
+        Name = "ECSBenchmark";
+        SourceRootPath = @"Source";
+    }
+
+    public override void ConfigureAll(Project.Configuration conf, CommonTarget target)
+    {
+        base.ConfigureAll(conf, target);
+        conf.Output = Configuration.OutputType.Exe;
+        conf.SolutionFolder = "Tools";
+
+        conf.IncludePaths.Add("[project.SourceRootPath]");
+        conf.TargetPath = Globals.RootDir + "/.build/[target.Name]/";
+        conf.VcxprojUserFile.LocalDebuggerWorkingDirectory = "[project.SharpmakeCsPath]";
+
+        conf.AddPublicDependency<Dementia>(target, DependencySetting.Default);
+        conf.AddPublicDependency<Engine>(target, DependencySetting.Default);
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// Stands in for Source/PCH.h in the Linux benchmark build, only what the ECS sources rely on.
+#include "Dementia.h"
+#include "Pointers.h"
+#include "optick.h"
+
+// std
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <iostream>
+#include <optional>
+
+#include <JSON.h>
+
+#include <CLog.h>
@@ -0,0 +1,8 @@
+#pragma once
+
+// Used by the Linux benchmark build when ThirdParty/Optick is not checked out, profiling is compiled out either way.
+#define OPTICK_EVENT(...)
+#define OPTICK_CATEGORY(...)
+#define OPTICK_THREAD(...)
+#define OPTICK_FRAME(...)
+#define OPTICK_TAG(...)
@@ -0,0 +1,120 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+#include <new>
+
+namespace
+{
+	std::atomic<std::uint64_t> AllocationCount{ 0 };
+}
+
+// Every allocation in the process goes through these, including the engine's pooled component slabs
+void* operator new(std::size_t InSize)
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* Ptr = std::malloc(InSize ? InSize : 1))
+	{
+		return Ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t InSize)
+{
+	return operator new(InSize);
+}
+
+void* operator new(std::size_t InSize, const std::nothrow_t&) noexcept
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(InSize ? InSize : 1);
+}
+
+void* operator new[](std::size_t InSize, const std::nothrow_t& InTag) noexcept
+{
+	return operator new(InSize, InTag);
+}
+
+void operator delete(void* InPtr) noexcept
+{
+	std::free(InPtr);
+}
+
+void operator delete[](void* InPtr) noexcept
+{
+	std::free(InPtr);
+}
+
+void operator delete(void* InPtr, std::size_t) noexcept
+{
+	std::free(InPtr);
+}
+
+void operator delete[](void* InPtr, std::size_t) noexcept
+{
+	std::free(InPtr);
+}
+
+// Over-aligned allocations, the component pool slabs come through here
+void* operator new(std::size_t InSize, std::align_val_t InAlignment)
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	const std::size_t Alignment = static_cast<std::size_t>(InAlignment);
+#if defined(_MSC_VER)
+	void* Ptr = _aligned_malloc(InSize ? InSize : 1, Alignment);
+#else
+	// aligned_alloc wants the size to be a multiple of the alignment
+	void* Ptr = std::aligned_alloc(Alignment, ((InSize ? InSize : 1) + Alignment - 1) / Alignment * Alignment);
+#endif
+	if (!Ptr)
+	{
+		throw std::bad_alloc();
+	}
+	return Ptr;
+}
+
+void* operator new[](std::size_t InSize, std::align_val_t InAlignment)
+{
+	return operator new(InSize, InAlignment);
+}
+
+void operator delete(void* InPtr, std::align_val_t) noexcept
+{
+#if defined(_MSC_VER)
+	_aligned_free(InPtr);
+#else
+	std::free(InPtr);
+#endif
+}
+
+void operator delete[](void* InPtr, std::align_val_t InAlignment) noexcept
+{
+	operator delete(InPtr, InAlignment);
+}
+
+void operator delete(void* InPtr, std::size_t, std::align_val_t InAlignment) noexcept
+{
+	operator delete(InPtr, InAlignment);
+}
+
+void operator delete[](void* InPtr, std::size_t, std::align_val_t InAlignment) noexcept
+{
+	operator delete(InPtr, InAlignment);
+}
+
+namespace Benchmark
+{
+	std::uint64_t GetAllocationCount()
+	{
+		return AllocationCount.load(std::memory_order_relaxed);
+	}
+
+	std::vector<Entry>& GetRegistry()
+	{
+		static std::vector<Entry> Registry;
+		return Registry;
+	}
+}
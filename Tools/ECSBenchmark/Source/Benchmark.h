@@ -0,0 +1,98 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tiny benchmark harness, no dependencies besides the standard library.
+// A benchmark does its setup untimed and wraps the part it wants measured in Run.Measure:
+//     ME_BENCHMARK(CreateEntity)
+//     {
+//         World GameWorld(Run.GetEntityCount());
+//         Run.Measure(Run.GetEntityCount(), [&]() { ... });
+//     }
+namespace Benchmark
+{
+	// Heap allocations made by this process so far, counted by the global operator new replacement in Benchmark.cpp
+	std::uint64_t GetAllocationCount();
+
+	class Run
+	{
+	public:
+		Run(std::size_t InEntityCount)
+			: EntityCount(InEntityCount)
+		{
+		}
+
+		// Times InBody, InOpCount is the number of operations it performs.
+		// Can be called more than once per run, the results add up.
+		template<typename Func>
+		void Measure(std::size_t InOpCount, Func&& InBody)
+		{
+			const std::uint64_t AllocsBefore = GetAllocationCount();
+			const auto Start = std::chrono::steady_clock::now();
+			InBody();
+			const auto End = std::chrono::steady_clock::now();
+
+			Allocations += GetAllocationCount() - AllocsBefore;
+			Nanoseconds += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start).count());
+			OpCount += InOpCount;
+		}
+
+		std::size_t GetEntityCount() const
+		{
+			return EntityCount;
+		}
+
+		double GetNanosecondsPerOp() const
+		{
+			return OpCount ? Nanoseconds / static_cast<double>(OpCount) : 0.0;
+		}
+
+		double GetAllocationsPerOp() const
+		{
+			return OpCount ? static_cast<double>(Allocations) / static_cast<double>(OpCount) : 0.0;
+		}
+
+	private:
+		std::size_t EntityCount = 0;
+		std::size_t OpCount = 0;
+		double Nanoseconds = 0.0;
+		std::uint64_t Allocations = 0;
+	};
+
+	typedef void (*BenchmarkFunc)(Run&);
+
+	struct Entry
+	{
+		std::string Name;
+		BenchmarkFunc Func;
+	};
+
+	std::vector<Entry>& GetRegistry();
+
+	struct Registration
+	{
+		Registration(const char* InName, BenchmarkFunc InFunc)
+		{
+			GetRegistry().push_back({ InName, InFunc });
+		}
+	};
+
+	// Keeps the compiler from throwing away results that are never read
+	template<typename T>
+	inline void DoNotOptimize(const T& InValue)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(InValue) : "memory");
+#else
+		static volatile const void* Sink;
+		Sink = &InValue;
+#endif
+	}
+}
+
+#define ME_BENCHMARK(NAME)                                                               \
+	static void Benchmark_##NAME(Benchmark::Run& Run);                                   \
+	static const Benchmark::Registration BenchmarkRegistration_##NAME(#NAME, &Benchmark_##NAME); \
+	static void Benchmark_##NAME(Benchmark::Run& Run)
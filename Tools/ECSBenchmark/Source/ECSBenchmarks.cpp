@@ -0,0 +1,245 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <utility>
+
+#include "ECS/Component.h"
+#include "ECS/Core.h"
+#include "Engine/World.h"
+
+// Everything here drives a World directly, the Engine singleton, windows and renderers are never created.
+// Only ECS and Dementia code is used so the Linux CMake build does not need glm or Bullet.
+namespace
+{
+	struct BenchVector
+	{
+		float x = 0.f;
+		float y = 0.f;
+		float z = 0.f;
+
+		BenchVector& operator+=(const BenchVector& Other)
+		{
+			x += Other.x;
+			y += Other.y;
+			z += Other.z;
+			return *this;
+		}
+	};
+
+	class BenchPosition
+		: public Component<BenchPosition>
+	{
+	public:
+		BenchPosition()
+			: Component("BenchPosition")
+		{
+		}
+
+		BenchVector Value;
+
+	private:
+		virtual void OnSerialize(json& outJson) final {}
+		virtual void OnDeserialize(const json& inJson) final {}
+	};
+
+	class BenchVelocity
+		: public Component<BenchVelocity>
+	{
+	public:
+		BenchVelocity()
+			: Component("BenchVelocity")
+			, Value{ 1.f, 2.f, 3.f }
+		{
+		}
+
+		BenchVector Value;
+
+	private:
+		virtual void OnSerialize(json& outJson) final {}
+		virtual void OnDeserialize(const json& inJson) final {}
+	};
+
+	// Distinct core types so a world can hold several of them
+	template<int Index>
+	class BenchCore
+		: public Core<BenchCore<Index>>
+	{
+	public:
+		typedef Core<BenchCore<Index>> Base;
+
+		BenchCore()
+			: Base(ComponentFilter().Requires<BenchPosition>().Requires<BenchVelocity>())
+		{
+		}
+	};
+
+	// Cores are owned by the caller and have to outlive the world they are added to
+	template<int... Indices>
+	void SimulateWithCores(Benchmark::Run& Run, std::integer_sequence<int, Indices...>)
+	{
+		const std::size_t Count = Run.GetEntityCount();
+		std::tuple<BenchCore<Indices>...> Cores;
+
+		World GameWorld(Count);
+		GameWorld.IsLoading = false;
+		(GameWorld.AddCore(std::get<BenchCore<Indices>>(Cores)), ...);
+
+		std::vector<EntityHandle> Handles = GameWorld.CreateEntities<BenchPosition, BenchVelocity>(Count);
+		Run.Measure(Count, [&]() {
+			GameWorld.Simulate();
+		});
+
+		GameWorld.DestroyEntities(Handles);
+		Run.Measure(Count, [&]() {
+			GameWorld.Simulate();
+		});
+	}
+}
+
+ME_BENCHMARK(EntityCreateDestroy)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+
+	std::vector<EntityHandle> Handles;
+	Handles.reserve(Count);
+	Run.Measure(Count, [&]() {
+		for (std::size_t i = 0; i < Count; ++i)
+		{
+			Handles.push_back(GameWorld.CreateEntity());
+		}
+		GameWorld.DestroyEntities(Handles);
+		GameWorld.Simulate();
+	});
+}
+
+ME_BENCHMARK(EntityCreateDestroyBulk)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+
+	Run.Measure(Count, [&]() {
+		std::vector<EntityHandle> Handles = GameWorld.CreateEntities<BenchPosition, BenchVelocity>(Count);
+		GameWorld.DestroyEntities(Handles);
+		GameWorld.Simulate();
+	});
+}
+
+ME_BENCHMARK(AddRemoveComponent)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+
+	std::vector<EntityHandle> Handles = GameWorld.CreateEntities<BenchPosition>(Count);
+	GameWorld.Simulate();
+
+	Run.Measure(Count * 2, [&]() {
+		for (const EntityHandle& Handle : Handles)
+		{
+			Handle->AddComponent<BenchVelocity>();
+		}
+		for (const EntityHandle& Handle : Handles)
+		{
+			Handle->RemoveComponent<BenchVelocity>();
+		}
+	});
+}
+
+ME_BENCHMARK(Simulate_1Core)
+{
+	SimulateWithCores(Run, std::make_integer_sequence<int, 1>{});
+}
+
+ME_BENCHMARK(Simulate_4Cores)
+{
+	SimulateWithCores(Run, std::make_integer_sequence<int, 4>{});
+}
+
+ME_BENCHMARK(Simulate_16Cores)
+{
+	SimulateWithCores(Run, std::make_integer_sequence<int, 16>{});
+}
+
+ME_BENCHMARK(GetComponentRandom)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+
+	std::vector<EntityID> Ids;
+	for (const EntityHandle& Handle : GameWorld.CreateEntities<BenchPosition>(Count))
+	{
+		Ids.push_back(Handle.GetId());
+	}
+	GameWorld.Simulate();
+
+	// Fixed seed so every run walks the same order
+	std::shuffle(Ids.begin(), Ids.end(), std::mt19937(1234));
+
+	float Sum = 0.f;
+	Run.Measure(Count, [&]() {
+		for (const EntityID& Id : Ids)
+		{
+			Sum += GameWorld.GetEntityRaw(Id)->GetComponent<BenchPosition>().Value.x;
+		}
+	});
+	Benchmark::DoNotOptimize(Sum);
+}
+
+ME_BENCHMARK(CoreIteration)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	BenchCore<0> MoveCore;
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+	GameWorld.AddCore(MoveCore);
+
+	GameWorld.CreateEntities<BenchPosition, BenchVelocity>(Count);
+	GameWorld.Simulate();
+
+	Run.Measure(Count, [&]() {
+		for (Entity& InEntity : MoveCore.GetEntities())
+		{
+			InEntity.GetComponent<BenchPosition>().Value += InEntity.GetComponent<BenchVelocity>().Value;
+		}
+	});
+}
+
+ME_BENCHMARK(QueryIteration)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+
+	GameWorld.CreateEntities<BenchPosition, BenchVelocity>(Count);
+	GameWorld.Simulate();
+
+	Run.Measure(Count, [&]() {
+		GameWorld.Query<BenchPosition, const BenchVelocity>().Each([](BenchPosition& Position, const BenchVelocity& Velocity) {
+			Position.Value += Velocity.Value;
+		});
+	});
+}
+
+ME_BENCHMARK(EntityHandleDeref)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	World GameWorld(Count);
+	GameWorld.IsLoading = false;
+
+	std::vector<EntityHandle> Handles = GameWorld.CreateEntities<BenchPosition>(Count);
+	GameWorld.Simulate();
+
+	float Sum = 0.f;
+	Run.Measure(Count, [&]() {
+		for (const EntityHandle& Handle : Handles)
+		{
+			Sum += Handle->GetComponent<BenchPosition>().Value.y;
+		}
+	});
+	Benchmark::DoNotOptimize(Sum);
+}
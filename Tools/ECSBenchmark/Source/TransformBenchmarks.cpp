@@ -0,0 +1,46 @@
+#include "Benchmark.h"
+
+#include "Components/Transform.h"
+#include "Cores/SceneCore.h"
+#include "Engine/World.h"
+#include "Math/Vector3.h"
+
+// Needs the Engine components, so only the Sharpmake build compiles this file.
+// A forest of small hierarchies, a quarter of the roots move every frame
+ME_BENCHMARK(TransformUpdate)
+{
+	const std::size_t Count = Run.GetEntityCount();
+	SceneCore Scene;
+	World GameWorld(Count + 1);
+	GameWorld.IsLoading = false;
+	GameWorld.AddCore(Scene);
+	Scene.Init();
+
+	std::vector<EntityHandle> Handles = GameWorld.CreateEntities<Transform>(Count);
+	GameWorld.Simulate();
+
+	std::vector<Transform*> Roots;
+	for (std::size_t i = 0; i < Count; ++i)
+	{
+		Transform& Current = Handles[i]->GetComponent<Transform>();
+		if (i % 8 == 0)
+		{
+			Roots.push_back(&Current);
+		}
+		else
+		{
+			Current.SetParent(Handles[i - 1]->GetComponent<Transform>());
+		}
+		Current.SetPosition(Vector3(1.f, 0.f, 0.f));
+	}
+	Scene.UpdateWorldMatrices();
+
+	Run.Measure(Count, [&]() {
+		for (std::size_t i = 0; i < Roots.size(); i += 4)
+		{
+			Roots[i]->Translate(Vector3(0.f, 0.1f, 0.f));
+		}
+		Scene.UpdateWorldMatrices();
+	});
+	Benchmark::DoNotOptimize(Roots.back()->GetMatrix());
+}
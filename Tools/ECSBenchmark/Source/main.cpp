@@ -0,0 +1,183 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+// Usage: ECSBenchmark [--entities N] [--repeat R] [--filter Text] [--csv Out.csv] [--baseline In.csv] [--tolerance 0.15]
+// Every benchmark runs R times and the median is reported, the minimum is printed next to it to show the noise.
+// With --baseline the process exits with 1 if any median ns/op is more than tolerance slower than the baseline csv.
+namespace
+{
+	struct Options
+	{
+		std::size_t EntityCount = 10000;
+		std::size_t Repeat = 7;
+		std::string Filter;
+		std::string CsvPath;
+		std::string BaselinePath;
+		double Tolerance = 0.15;
+	};
+
+	struct Result
+	{
+		std::string Name;
+		double MedianNs = 0.0;
+		double MinNs = 0.0;
+		double AllocsPerOp = 0.0;
+	};
+
+	bool ParseOptions(int argc, char** argv, Options& OutOptions)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* Arg = argv[i];
+			const char* Value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+			if (!Value)
+			{
+				std::fprintf(stderr, "Missing value for %s\n", Arg);
+				return false;
+			}
+
+			if (std::strcmp(Arg, "--entities") == 0)
+			{
+				OutOptions.EntityCount = std::strtoull(Value, nullptr, 10);
+			}
+			else if (std::strcmp(Arg, "--repeat") == 0)
+			{
+				OutOptions.Repeat = std::max<std::size_t>(1, std::strtoull(Value, nullptr, 10));
+			}
+			else if (std::strcmp(Arg, "--filter") == 0)
+			{
+				OutOptions.Filter = Value;
+			}
+			else if (std::strcmp(Arg, "--csv") == 0)
+			{
+				OutOptions.CsvPath = Value;
+			}
+			else if (std::strcmp(Arg, "--baseline") == 0)
+			{
+				OutOptions.BaselinePath = Value;
+			}
+			else if (std::strcmp(Arg, "--tolerance") == 0)
+			{
+				OutOptions.Tolerance = std::strtod(Value, nullptr);
+			}
+			else
+			{
+				std::fprintf(stderr, "Unknown option %s\n", Arg);
+				return false;
+			}
+			++i;
+		}
+		return true;
+	}
+
+	Result RunBenchmark(const Benchmark::Entry& InEntry, const Options& InOptions)
+	{
+		// One untimed pass to warm caches and let pools reach their steady state
+		{
+			Benchmark::Run Warmup(InOptions.EntityCount);
+			InEntry.Func(Warmup);
+		}
+
+		std::vector<double> Samples;
+		Result Out;
+		Out.Name = InEntry.Name;
+		for (std::size_t i = 0; i < InOptions.Repeat; ++i)
+		{
+			Benchmark::Run Run(InOptions.EntityCount);
+			InEntry.Func(Run);
+			Samples.push_back(Run.GetNanosecondsPerOp());
+			Out.AllocsPerOp = Run.GetAllocationsPerOp();
+		}
+
+		std::sort(Samples.begin(), Samples.end());
+		Out.MedianNs = Samples[Samples.size() / 2];
+		Out.MinNs = Samples.front();
+		return Out;
+	}
+
+	std::map<std::string, double> LoadBaseline(const std::string& InPath)
+	{
+		std::map<std::string, double> Baseline;
+		std::ifstream File(InPath);
+		std::string Line;
+		std::getline(File, Line);
+		while (std::getline(File, Line))
+		{
+			std::stringstream Stream(Line);
+			std::string Name;
+			std::string MedianNs;
+			if (std::getline(Stream, Name, ',') && std::getline(Stream, MedianNs, ','))
+			{
+				Baseline[Name] = std::strtod(MedianNs.c_str(), nullptr);
+			}
+		}
+		return Baseline;
+	}
+
+	void WriteCsv(const std::string& InPath, const std::vector<Result>& InResults)
+	{
+		std::ofstream File(InPath);
+		File << "name,median_ns_per_op,min_ns_per_op,allocs_per_op\n";
+		for (const Result& InResult : InResults)
+		{
+			File << InResult.Name << ',' << InResult.MedianNs << ',' << InResult.MinNs << ',' << InResult.AllocsPerOp << '\n';
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options Opts;
+	if (!ParseOptions(argc, argv, Opts))
+	{
+		return 2;
+	}
+
+	std::vector<Benchmark::Entry> Entries = Benchmark::GetRegistry();
+	std::sort(Entries.begin(), Entries.end(), [](const Benchmark::Entry& A, const Benchmark::Entry& B) {
+		return A.Name < B.Name;
+	});
+
+	std::printf("%zu entities, median of %zu runs\n\n", Opts.EntityCount, Opts.Repeat);
+	std::printf("%-32s %14s %14s %12s\n", "Benchmark", "ns/op", "min ns/op", "allocs/op");
+
+	std::vector<Result> Results;
+	for (const Benchmark::Entry& InEntry : Entries)
+	{
+		if (!Opts.Filter.empty() && InEntry.Name.find(Opts.Filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		Results.push_back(RunBenchmark(InEntry, Opts));
+		const Result& Last = Results.back();
+		std::printf("%-32s %14.2f %14.2f %12.3f\n", Last.Name.c_str(), Last.MedianNs, Last.MinNs, Last.AllocsPerOp);
+	}
+
+	if (!Opts.CsvPath.empty())
+	{
+		WriteCsv(Opts.CsvPath, Results);
+	}
+
+	int ExitCode = 0;
+	if (!Opts.BaselinePath.empty())
+	{
+		const std::map<std::string, double> Baseline = LoadBaseline(Opts.BaselinePath);
+		for (const Result& InResult : Results)
+		{
+			auto it = Baseline.find(InResult.Name);
+			if (it != Baseline.end() && InResult.MedianNs > it->second * (1.0 + Opts.Tolerance))
+			{
+				std::printf("REGRESSION %s: %.2f ns/op vs %.2f baseline\n", InResult.Name.c_str(), InResult.MedianNs, it->second);
+				ExitCode = 1;
+			}
+		}
+	}
+	return ExitCode;
+}